@@ -21,173 +21,272 @@
 #include "Uart1.h"
 #include "Negotiation.h"
 #include "Field.h"
+#include "FieldDensity.h"
+#include "Random.h"
 
-struct Agent {
-    AgentState state;
-    Message msg;
-    NegotiationData secret;
-    NegotiationData hash;
-    Field own_field;
-    Field opp_field;
-    
-};
-
-static struct Agent agent;
-static int turnCount = 0;
-static char *newGameMsg = "Press BTN4 to start\n";
-static char *errorMsg;
-static char *cheatMsg = "Cheating detected: sending to end screen.";
-static char *defeatMsg = "Defeated! You lost.";
-static char *victoryMsg = "Victory! You won";
-static FieldOledTurn gameTurn;
+static AgentContext agent;
+static uint32_t agentSeed = 0;
+static const char *newGameMsg = "Press BTN4 to start\n";
+static const char *cheatMsg = "Cheating detected: sending to end screen.";
+static const char *defeatMsg = "Defeated! You lost.";
+static const char *victoryMsg = "Victory! You won";
 #define RANDSIZE 0xFFFFF
 #define BOATSSUNK 0b00000000
+
+/**
+ * Shows `text` on the OLED, if this agent owns it.
+ */
+static void AgentShowMessage(const AgentContext *context, const char *text)
+{
+    if (context->display) {
+        OledClear(OLED_COLOR_BLACK);
+        OledDrawString((char *) text);
+        OledUpdate();
+    }
+}
+
 /*
  * 
  */
 void AgentInit(void) {
-    agent.state = AGENT_STATE_START;
-    gameTurn = FIELD_OLED_TURN_NONE
-    turnCount = 0;
-    OledClear(OLED_COLOR_BLACK);
-    OledDrawString(newGameMsg);
-    OledUpdate();
+    AgentContextInit(&agent, TRUE, agentSeed);
+}
+
+void AgentSeedRandom(uint32_t seed) {
+    agentSeed = seed;
+    RandomSeed(&agent.rng, seed);
+}
+
+void AgentStirRandom(uint32_t entropy) {
+    RandomStir(&agent.rng, entropy);
+}
+
+void AgentSetCombinedTurns(uint8_t combined) {
+    AgentContextSetCombinedTurns(&agent, combined);
+}
+
+void AgentContextSetCombinedTurns(AgentContext *context, uint8_t combined) {
+    context->combined_turns = combined;
+}
+
+/**
+ * Clears everything about the current game, but not the random stream or the AI.
+ */
+static void AgentContextReset(AgentContext *context, uint8_t display) {
+    AgentContext kept = *context;
+    memset(context, 0, sizeof (*context));
+    context->rng = kept.rng;
+    context->place_boats = kept.place_boats;
+    context->decide_guess = kept.decide_guess;
+    context->state = AGENT_STATE_START;
+    context->msg.type = MESSAGE_NONE;
+    context->turn = FIELD_OLED_TURN_NONE;
+    context->turn_count = 0;
+    context->display = display;
+    AgentShowMessage(context, newGameMsg);
+}
+
+void AgentContextInit(AgentContext *context, uint8_t display, uint32_t seed) {
+    RandomSeed(&context->rng, seed);
+    context->place_boats = NULL;
+    context->decide_guess = NULL;
+    AgentContextReset(context, display);
+}
+
+/**
+ * Sets up both fields for a new game and places our boats.
+ */
+static void AgentStartGame(AgentContext *context) {
+    FieldInit(&context->own_field, &context->opp_field);
+    if (!context->decide_guess) {
+        FieldDensityInit(&context->opp_density, &context->opp_field);
+    }
+    if (context->place_boats) {
+        context->place_boats(&context->own_field, &context->rng);
+    } else {
+        FieldAIPlaceAllBoatsWith(&context->own_field, &context->rng);
+    }
+}
+
+/**
+ * Decides our next shot and makes it the message to send.
+ */
+static void AgentShoot(AgentContext *context) {
+    GuessData gData;
+    if (context->decide_guess) {
+        gData = context->decide_guess(&context->opp_field, &context->rng);
+    } else {
+        gData = FieldDensityDecideGuess(&context->opp_density, &context->opp_field, &context->rng);
+    }
+    context->last_shot = gData;
+    context->msg.type = MESSAGE_SHO;
+    context->msg.param0 = gData.row;
+    context->msg.param1 = gData.col;
+}
+
+/**
+ * Takes the opponent's shot at (row, col) and answers it: with a RES, or with a RAS carrying our
+ * next shot as well if turns are combined.
+ */
+static void AgentDefend(AgentContext *context, uint16_t row, uint16_t col) {
+    GuessData gData;
+    gData.row = row;
+    gData.col = col;
+    FieldRegisterEnemyAttack(&context->own_field, &gData);
+    //defeat
+    if (FieldGetBoatStates(&context->own_field) == BOATSSUNK) {
+        //the RES still goes out, so the opponent learns of its victory
+        context->msg.type = MESSAGE_RES;
+        context->msg.param0 = row;
+        context->msg.param1 = col;
+        context->msg.param2 = gData.result;
+        AgentShowMessage(context, defeatMsg);
+        context->state = AGENT_STATE_END_SCREEN;
+    } else if (context->combined_turns) {
+        //decide guess, send it with the result as a RAS
+        context->turn_count++;
+        AgentShoot(context);
+        context->msg.type = MESSAGE_RAS;
+        context->msg.param0 = gData.result;
+        context->msg.param1 = context->last_shot.row;
+        context->msg.param2 = context->last_shot.col;
+        context->state = AGENT_STATE_ATTACKING;
+    } else {
+        //send RES, then SHO once it is out
+        context->msg.type = MESSAGE_RES;
+        context->msg.param0 = row;
+        context->msg.param1 = col;
+        context->msg.param2 = gData.result;
+        context->state = AGENT_STATE_WAITING_TO_SEND;
+    }
+}
+
+/**
+ * Records the result of our last shot, and returns TRUE if it won the game.
+ */
+static uint8_t AgentRecordResult(AgentContext *context, GuessData *gData) {
+    FieldUpdateKnowledge(&context->opp_field, gData);
+    if (!context->decide_guess) {
+        FieldDensityUpdate(&context->opp_density, &context->opp_field, gData);
+    }
+    //check for victory
+    if (FieldGetBoatStates(&context->opp_field) == BOATSSUNK) {
+        AgentShowMessage(context, victoryMsg);
+        context->state = AGENT_STATE_END_SCREEN;
+        return TRUE;
+    }
+    context->state = AGENT_STATE_DEFENDING;
+    return FALSE;
 }
 
 Message AgentRun(BB_Event event) {
+    return AgentContextRun(&agent, event);
+}
+
+Message AgentContextRun(AgentContext *context, BB_Event event) {
+    const char *errorMsg = NULL;
+
+    // Only the reply to this event is returned, never one already handed back.
+    context->msg.type = MESSAGE_NONE;
     switch (event.type) {
         case BB_EVENT_START_BUTTON:
-            if (agent.state == AGENT_STATE_START) {
+            if (context->state == AGENT_STATE_START) {
                 //generate A, #a
-                agent.secret = rand() & RANDSIZE;
-                //send CHA
-                agent.msg.param0 = agent.secret;
-                agent.msg.type = MESSAGE_CHA
-                //initialize fields
-                FieldInit(&agent.own_field, &agent.opp_field);
-                //place own boats
-                FieldAIPlaceAllBoats(&agent.own_field, &agent.opp_field);
-                agent.state = AGENT_STATE_CHALLENGING;
+                context->secret = RandomNext(&context->rng) & RANDSIZE;
+                context->hash = NegotiationHash(context->secret);
+                //send CHA, committing to A with #a
+                context->msg.param0 = context->hash;
+                context->msg.type = MESSAGE_CHA;
+                //initialize fields and place own boats
+                AgentStartGame(context);
+                context->state = AGENT_STATE_CHALLENGING;
             }
             break;
         case BB_EVENT_RESET_BUTTON:
             //reset all data
-            AgentInit();
+            AgentContextReset(context, context->display);
             break;
         case BB_EVENT_ACC_RECEIVED:
-            if (agent.state == AGENT_STATE_CHALLENGING) {
+            if (context->state == AGENT_STATE_CHALLENGING) {
                 //send REV
                 //go to heads or tails
-                agent.msg.type = MESSAGE_REV;
-                agent.msg.param0 = agent.secret;
-                NegotiationOutcome coinToss = NegotiateCoinFlip(agent.secret, event.param0);
+                context->msg.type = MESSAGE_REV;
+                context->msg.param0 = context->secret;
+                NegotiationOutcome coinToss = NegotiateCoinFlip(context->secret, event.param0);
                 if (coinToss == HEADS) {
-                    agent.state = AGENT_STATE_WAITING_TO_SEND;
+                    context->state = AGENT_STATE_WAITING_TO_SEND;
                 }
                 else if (coinToss == TAILS) {
-                    agent.state = AGENT_STATE_DEFENDING;
+                    context->state = AGENT_STATE_DEFENDING;
                 }
             }
             break;
         case BB_EVENT_CHA_RECEIVED:
-            if (agent.state == AGENT_STATE_START) {
-                //generate B
-                agent.secret = rand() & RANDSIZE;
-                agent.msg.param0 = agent.secret;
-                agent.msg.type = MESSAGE_ACC;        
+            if (context->state == AGENT_STATE_START) {
+                //remember #a, generate B
+                context->hash = event.param0;
+                context->secret = RandomNext(&context->rng) & RANDSIZE;
+                context->msg.param0 = context->secret;
+                context->msg.type = MESSAGE_ACC;        
                 //send ACC
                 
                 
-                //initialize fields
-                FieldInit(&agent.own_field, &agent.opp_field);
-                //place own boats
-                FieldAIPlaceAllBoats(&agent.own_field);
-                agent.state = AGENT_STATE_ACCEPTING;
+                //initialize fields and place own boats
+                AgentStartGame(context);
+                context->state = AGENT_STATE_ACCEPTING;
             }
             break;
         case BB_EVENT_REV_RECEIVED:
-            if (agent.state == AGENT_STATE_ACCEPTING) {
+            if (context->state == AGENT_STATE_ACCEPTING) {
                 //detect cheating
-                NegotiationOutcome coinToss = NegotiateCoinFlip(agent.secret, event.param0);
-                if (NegotiationVerify(event.param0, agent.hash) == FALSE) {
-                    OledDrawString(cheatMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
+                NegotiationOutcome coinToss = NegotiateCoinFlip(context->secret, event.param0);
+                if (NegotiationVerify(event.param0, context->hash) == FALSE) {
+                    AgentShowMessage(context, cheatMsg);
+                    context->state = AGENT_STATE_END_SCREEN;
                     break;
                 }
                 
                 if (coinToss == TAILS) {
-                    GuessData gData = FieldAIDecideGuess(&agent.opp_field);
-                    agent.msg.type = MESSAGE_SHO;
-                    agent.msg.param0 = gData.row;
-                    agent.msg.param1 = gData.col;
-                    agent.state = AGENT_STATE_ATTACKING;
+                    AgentShoot(context);
+                    context->state = AGENT_STATE_ATTACKING;
                 }
                 else if (coinToss == HEADS) {
-                    agent.state = AGENT_STATE_DEFENDING;
+                    context->state = AGENT_STATE_DEFENDING;
                 }
                 //go to heads or tails
             }
             break;
         case BB_EVENT_SHO_RECEIVED:
-            if (agent.state == AGENT_STATE_DEFENDING) {
-                //update own field
-                GuessData gData;
-                gData.row = event.param0;
-                gData.col = event.param1;
-                FieldRegisterEnemyAttack(&agent.own_field, &gData);
-                //send RES
-                agent.msg.type = MESSAGE_RES;
-                agent.msg.param0 = event.param0;
-                agent.msg.param1 = event.param1;
-                agent.msg.param2 = gData.result;
-                uint8_t boatStates = FieldGetBoatStates(&agent.own_field);       
-                //defeat
-                if (boatStates == BOATSSUNK) {
-                    agent.msg.type = MESSAGE_NONE;
-                    OledClear(OLED_COLOR_BLACK);
-                    OledDrawString(defeatMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
-                }
-                else {
-                    agent.state = AGENT_STATE_WAITING_TO_SEND;
-                }
-                            
+            if (context->state == AGENT_STATE_DEFENDING) {
+                //update own field, send RES (or RAS)
+                AgentDefend(context, event.param0, event.param1);
             }
             break;
         case BB_EVENT_MESSAGE_SENT:
-            if (agent.state == AGENT_STATE_WAITING_TO_SEND) {
-                turnCount++;
-                //decide guess
-                GuessData gData = FieldAIDecideGuess(&agent.opp_field);
-                //send SHO
-                agent.msg.type = MESSAGE_SHO;
-                agent.msg.param0 = gData.row;
-                agent.msg.param1 = gData.col;
-                agent.state = AGENT_STATE_ATTACKING;
+            if (context->state == AGENT_STATE_WAITING_TO_SEND) {
+                context->turn_count++;
+                //decide guess, send SHO
+                AgentShoot(context);
+                context->state = AGENT_STATE_ATTACKING;
             }
             break;
         case BB_EVENT_RES_RECEIVED:
-            if (agent.state == AGENT_STATE_ATTACKING) {
+            if (context->state == AGENT_STATE_ATTACKING) {
                 //update record of enemy field
-                
                 GuessData gData;
                 gData.row = event.param0;
                 gData.col = event.param1;
                 gData.result = event.param2;
-                //check for victory
-                FieldUpdateKnowledge(&agent.opp_field, &gData);
-                uint8_t boatStates = FieldGetBoatStates(&agent.opp_field);
-                if (boatStates == BOATSSUNK) {
-                    OledClear(OLED_COLOR_BLACK);
-                    OledDrawString(victoryMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
-                }
-                else {
-                    
-                    agent.state = AGENT_STATE_DEFENDING;
+                AgentRecordResult(context, &gData);
+            }
+            break;
+        case BB_EVENT_RAS_RECEIVED:
+            if (context->state == AGENT_STATE_ATTACKING) {
+                //the result is for our last shot; unless it won, defend against the new one
+                GuessData gData = context->last_shot;
+                gData.result = event.param0;
+                if (!AgentRecordResult(context, &gData)) {
+                    AgentDefend(context, event.param1, event.param2);
                 }
             }
             break;
@@ -196,61 +295,57 @@ Message AgentRun(BB_Event event) {
             switch (event.param0) {
                 case BB_ERROR_BAD_CHECKSUM:
                     errorMsg = "ERROR: BAD CHECKSUM";
-                    OledClear(OLED_COLOR_BLACK);
-                    OledDrawString(errorMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
                     break;
                     //msg
                 case BB_ERROR_PAYLOAD_LEN_EXCEEDED:
                     errorMsg = "ERROR: PAYLOD LENGTH EXCEEDED";
-                    OledClear(OLED_COLOR_BLACK);
-                    OledDrawString(errorMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
                     break;
                     //msg
                 case BB_ERROR_CHECKSUM_LEN_EXCEEDED: 
                     errorMsg = "ERROR: CHECKSUM LENGTH EXCEEDED";
-                    OledClear(OLED_COLOR_BLACK);
-                    OledDrawString(errorMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
                     break;
                 case BB_ERROR_CHECKSUM_LEN_INSUFFICIENT:
                     errorMsg = "ERROR: CHECKSUM LENGTH INSUFFICIENT";
-                    OledClear(OLED_COLOR_BLACK);
-                    OledDrawString(errorMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
                     break;
                 case BB_ERROR_INVALID_MESSAGE_TYPE:
                     errorMsg = "ERROR: INVALID MESSAGE TYPE";
-                    OledClear(OLED_COLOR_BLACK);
-                    OledDrawString(errorMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
                     break;
                 case BB_ERROR_MESSAGE_PARSE_FAILURE:
                     errorMsg = "ERROR: MESSAGE PARSE FAILURE";
-                    OledClear(OLED_COLOR_BLACK);
-                    OledDrawString(errorMsg);
-                    OledUpdate();
-                    agent.state = AGENT_STATE_END_SCREEN;
                     break;
             }
-            
-            OledClear(OLED_COLOR_BLACK);
-            FieldOledDrawScreen(&agent.own_field, &agent.opp_field, gameTurn, turnCount);
-            OledUpdate();
-            return agent.msg;
+            if (errorMsg != NULL) {
+                AgentShowMessage(context, errorMsg);
+                context->state = AGENT_STATE_END_SCREEN;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // In START the screen shows the new game prompt, and at the end the result or the error.
+    if (context->display && context->state != AGENT_STATE_START &&
+            context->state != AGENT_STATE_END_SCREEN) {
+        OledClear(OLED_COLOR_BLACK);
+        FieldOledDrawScreen(&context->own_field, &context->opp_field, context->turn,
+                context->turn_count);
+        OledUpdate();
     }
+    return context->msg;
 }
 
 AgentState AgentGetState(void) {
-    return agent.state;
+    return AgentContextGetState(&agent);
+}
 
+AgentState AgentContextGetState(const AgentContext *context) {
+    return context->state;
 }
+
 void AgentSetState(AgentState newState) {
-    agent.state = newState;
+    AgentContextSetState(&agent, newState);
+}
+
+void AgentContextSetState(AgentContext *context, AgentState newState) {
+    context->state = newState;
 }
\ No newline at end of file
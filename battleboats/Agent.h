@@ -4,6 +4,11 @@
 #include <stdint.h>
 #include "Message.h"
 #include "BattleBoats.h"
+#include "Field.h"
+#include "FieldDensity.h"
+#include "FieldOled.h"
+#include "Negotiation.h"
+#include "Random.h"
 
 /**
  * Defines the various states used within the agent state machines. All states should be used
@@ -23,6 +28,47 @@ typedef enum {
     AGENT_STATE_SETUP_BOATS, //7
 } AgentState;
 
+/**
+ * Everything one agent knows about its game. Each context is independent of every other, so one
+ * process can run many agents at once, e.g. both sides of a simulated game, or one game per
+ * thread. The AgentInit()/AgentRun()/AgentGetState()/AgentSetState() functions below act on a
+ * default context that the firmware uses.
+ *
+ * The OLED is shared by the whole board, so only a context initialized with `display` set draws
+ * on it. Contexts used for simulation should leave it clear.
+ *
+ * Every random choice the agent makes (its negotiation secret, its boat placement and its
+ * tie-breaks) is drawn from `rng`, so two contexts given the same seed and the same events play
+ * identically, whatever else runs alongside them.
+ *
+ * `place_boats` and `decide_guess` may be set after AgentContextInit() to swap in another AI,
+ * e.g. to compare two of them in a tournament. They are left NULL for the built-in AI,
+ * FieldAIPlaceAllBoatsWith() and the incremental density map.
+ *
+ * With `combined_turns` set (see AgentContextSetCombinedTurns()), a defender answers each SHO
+ * with a RAS, the RES and its own next SHO in one message, and goes straight from DEFENDING to
+ * ATTACKING. A RAS only carries the result: the attacker that receives one applies it to
+ * `last_shot`, then defends against the shot in it. A RAS is accepted whether or not
+ * `combined_turns` is set.
+ */
+typedef struct {
+    AgentState state;
+    Message msg;
+    NegotiationData secret;
+    NegotiationData hash;
+    Field own_field;
+    Field opp_field;
+    FieldDensity opp_density;
+    FieldOledTurn turn;
+    uint8_t turn_count;
+    uint8_t display;
+    uint8_t combined_turns;
+    GuessData last_shot;
+    RandomState rng;
+    uint8_t (*place_boats)(Field *own_field, RandomState *rng);
+    GuessData (*decide_guess)(const Field *opp_field, RandomState *rng);
+} AgentContext;
+
 /**
  * The Init() function for an Agent sets up everything necessary for an agent before the game
  * starts.  At a minimum, this requires:
@@ -30,10 +76,45 @@ typedef enum {
  *   -setting turn counter to 0
  * If you are using any other persistent data in Agent SM, that should be reset as well.
  * 
- * It is not advised to call srand() inside of AgentInit.  
+ * The default context is seeded with the last AgentSeedRandom() seed.
  *  */
 void AgentInit(void);
 
+/**
+ * Resets `context` for a new game, as AgentInit() does for the default context.
+ *
+ * @param context The agent to reset.
+ * @param display TRUE if this agent owns the OLED and should draw its game there.
+ * @param seed    Seeds the agent's random numbers. A reset through BB_EVENT_RESET_BUTTON
+ *                keeps drawing from the same stream rather than reseeding.
+ */
+void AgentContextInit(AgentContext *context, uint8_t display, uint32_t seed);
+
+/**
+ * Sets the seed that AgentInit() gives the default context, and reseeds it now. Repeatable
+ * tests (see UNSEEDED_MODE in Lab09_main.c) call this before AgentInit().
+ */
+void AgentSeedRandom(uint32_t seed);
+
+/**
+ * Mixes `entropy` into the default context's random numbers, e.g. the free-running timer at the
+ * moment a button is pressed or a character arrives.  Call it from the main loop, never from an
+ * interrupt: the Agent may be drawing from the same generator.
+ */
+void AgentStirRandom(uint32_t entropy);
+
+/**
+ * Sets whether the default context answers a SHO with a RAS. Only turn this on once the opponent
+ * has agreed to it; it is off after AgentInit() and after a reset.
+ */
+void AgentSetCombinedTurns(uint8_t combined);
+
+/**
+ * Sets whether `context` answers a SHO with a RAS, as AgentSetCombinedTurns() does for the
+ * default context.
+ */
+void AgentContextSetCombinedTurns(AgentContext *context, uint8_t combined);
+
 /**
  * AgentRun evolves the Agent state machine in response to an event.
  * 
@@ -48,6 +129,12 @@ void AgentInit(void);
  */
 Message AgentRun(BB_Event event);
 
+/**
+ * Evolves the state machine of `context` in response to an event, as AgentRun() does for the
+ * default context.
+ */
+Message AgentContextRun(AgentContext *context, BB_Event event);
+
 /** * 
  * @return Returns the current state that AgentGetState is in.  
  * 
@@ -55,6 +142,11 @@ Message AgentRun(BB_Event event);
  */
 AgentState AgentGetState(void);
 
+/**
+ * @return the current state of `context`.
+ */
+AgentState AgentContextGetState(const AgentContext *context);
+
 /** * 
  * @param Force the agent into the state given by AgentState
  * 
@@ -62,4 +154,9 @@ AgentState AgentGetState(void);
  */
 void AgentSetState(AgentState newState);
 
+/**
+ * Forces `context` into the state given by newState.
+ */
+void AgentContextSetState(AgentContext *context, AgentState newState);
+
 #endif // AGENT_H
@@ -7,12 +7,243 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "BOARD.h"
+#include "Agent.h"
+
+// Longest a game between two AI agents may take, in events delivered.
+#define MAX_GAME_EVENTS 1000
+
+/**
+ * The event an opponent sees when `message` arrives.
+ */
+static BB_Event ReceivedEvent(Message message)
+{
+    BB_Event event = {BB_EVENT_NO_EVENT, message.param0, message.param1, message.param2};
+    switch (message.type) {
+        case MESSAGE_CHA: event.type = BB_EVENT_CHA_RECEIVED;
+            break;
+        case MESSAGE_ACC: event.type = BB_EVENT_ACC_RECEIVED;
+            break;
+        case MESSAGE_REV: event.type = BB_EVENT_REV_RECEIVED;
+            break;
+        case MESSAGE_SHO: event.type = BB_EVENT_SHO_RECEIVED;
+            break;
+        case MESSAGE_RES: event.type = BB_EVENT_RES_RECEIVED;
+            break;
+        case MESSAGE_RAS: event.type = BB_EVENT_RAS_RECEIVED;
+            break;
+        default:
+            break;
+    }
+    return event;
+}
+
+/**
+ * Plays a whole game between two contexts, passing messages in memory in the order they were
+ * sent. Returns the number of events delivered, or 0 if the game did not finish.
+ */
+static int PlayGame(AgentContext *a, AgentContext *b)
+{
+    struct {
+        AgentContext *to;
+        BB_Event event;
+    } queue[8];
+    int head = 0, tail = 0, delivered = 0;
+
+    queue[tail].to = a;
+    queue[tail].event.type = BB_EVENT_START_BUTTON;
+    tail = (tail + 1) % 8;
+    while (head != tail && delivered < MAX_GAME_EVENTS) {
+        AgentContext *to = queue[head].to;
+        Message reply = AgentContextRun(to, queue[head].event);
+        head = (head + 1) % 8;
+        delivered++;
+        if (reply.type != MESSAGE_NONE) {
+            queue[tail].to = to == a ? b : a;
+            queue[tail].event = ReceivedEvent(reply);
+            tail = (tail + 1) % 8;
+            queue[tail].to = to;
+            queue[tail].event.type = BB_EVENT_MESSAGE_SENT;
+            tail = (tail + 1) % 8;
+        }
+    }
+    if (AgentContextGetState(a) != AGENT_STATE_END_SCREEN ||
+            AgentContextGetState(b) != AGENT_STATE_END_SCREEN) {
+        return 0;
+    }
+    return delivered;
+}
 
 /*
  * 
  */
 int main(int argc, char** argv) {
+    BOARD_Init();
+    int resCount = 0;
+    int i;
+    BB_Event start = {BB_EVENT_START_BUTTON, 0, 0, 0};
+    BB_Event reset = {BB_EVENT_RESET_BUTTON, 0, 0, 0};
+    static AgentContext a, b, c, d;
+    printf("Welcome to the Agent.c Test!\n");
+
+    printf("Now Testing AgentContextInit() and AgentContextRun()\n");
+    AgentContextInit(&a, FALSE, 1);
+    AgentContextInit(&b, FALSE, 2);
+    Message cha = AgentContextRun(&a, start);
+    if (cha.type == MESSAGE_CHA && cha.param0 == NegotiationHash(a.secret) &&
+            AgentContextGetState(&a) == AGENT_STATE_CHALLENGING) {
+        resCount++;
+    }
+    // b is untouched by a's game.
+    if (AgentContextGetState(&b) == AGENT_STATE_START) {
+        resCount++;
+    }
+    Message acc = AgentContextRun(&b, ReceivedEvent(cha));
+    if (acc.type == MESSAGE_ACC && b.hash == cha.param0 &&
+            AgentContextGetState(&b) == AGENT_STATE_ACCEPTING) {
+        resCount++;
+    }
+    // A message is only returned once.
+    BB_Event nothing = {BB_EVENT_NO_EVENT, 0, 0, 0};
+    if (AgentContextRun(&b, nothing).type == MESSAGE_NONE) {
+        resCount++;
+    }
+    AgentContextRun(&a, reset);
+    if (AgentContextGetState(&a) == AGENT_STATE_START &&
+            AgentContextGetState(&b) == AGENT_STATE_ACCEPTING) {
+        resCount++;
+    }
+    if (resCount == 5) {
+        printf("PASSED: 5/5 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/5 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing a full game between two contexts\n");
+    for (i = 0; i < 20; i++) {
+        AgentContextInit(&a, FALSE, 2 * i);
+        AgentContextInit(&b, FALSE, 2 * i + 1);
+        if (PlayGame(&a, &b) > 0 &&
+                (FieldGetBoatStates(&a.opp_field) == 0) != (FieldGetBoatStates(&b.opp_field) == 0)) {
+            resCount++;
+        }
+    }
+    if (resCount == 20) {
+        printf("PASSED: 20/20 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/20 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing seeded contexts\n");
+    // Games from the same seeds play out identically, even with another game in between.
+    AgentContextInit(&a, FALSE, 1234);
+    AgentContextInit(&b, FALSE, 5678);
+    int delivered = PlayGame(&a, &b);
+    FieldMask firstBoats[FIELD_NUM_BOATS];
+    memcpy(firstBoats, a.own_field.boats, sizeof (firstBoats));
+    AgentContextInit(&c, FALSE, 1);
+    AgentContextInit(&d, FALSE, 2);
+    PlayGame(&c, &d);
+    AgentContextInit(&c, FALSE, 1234);
+    AgentContextInit(&d, FALSE, 5678);
+    if (delivered > 0 && PlayGame(&c, &d) == delivered && a.secret == c.secret &&
+            memcmp(a.own_field.boats, c.own_field.boats, sizeof (a.own_field.boats)) == 0 &&
+            memcmp(&a.opp_field.unknown, &c.opp_field.unknown, sizeof (a.opp_field.unknown)) == 0 &&
+            memcmp(&b.opp_field.unknown, &d.opp_field.unknown, sizeof (b.opp_field.unknown)) == 0) {
+        resCount++;
+    }
+    AgentContextInit(&c, FALSE, 1235);
+    AgentContextInit(&d, FALSE, 5678);
+    PlayGame(&c, &d);
+    if (memcmp(a.own_field.boats, c.own_field.boats, sizeof (a.own_field.boats)) != 0) {
+        resCount++;
+    }
+    // A reset keeps drawing from the stream instead of replaying the same game.
+    AgentContextRun(&a, reset);
+    AgentContextInit(&b, FALSE, 5678);
+    PlayGame(&a, &b);
+    if (memcmp(a.own_field.boats, firstBoats, sizeof (firstBoats)) != 0) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing AgentContextSetCombinedTurns()\n");
+    // Combining turns changes no shot, only how many messages carry them: the same seeds play the
+    // same game in little more than half the messages, with one side combining or both.
+    uint8_t same = TRUE, shorter = TRUE;
+    for (i = 0; i < 10; i++) {
+        AgentContextInit(&a, FALSE, 100 + 2 * i);
+        AgentContextInit(&b, FALSE, 101 + 2 * i);
+        int separate = PlayGame(&a, &b);
+        AgentContextInit(&c, FALSE, 100 + 2 * i);
+        AgentContextInit(&d, FALSE, 101 + 2 * i);
+        AgentContextSetCombinedTurns(&c, TRUE);
+        AgentContextSetCombinedTurns(&d, i & 1);
+        int combined = PlayGame(&c, &d);
+        if (separate == 0 || combined == 0 || c.turn_count != a.turn_count ||
+                d.turn_count != b.turn_count ||
+                memcmp(&a.opp_field.unknown, &c.opp_field.unknown, sizeof (a.opp_field.unknown)) ||
+                memcmp(&b.opp_field.unknown, &d.opp_field.unknown, sizeof (b.opp_field.unknown))) {
+            same = FALSE;
+        }
+        if ((i & 1) && 10 * combined > 6 * separate) {
+            shorter = FALSE;
+        }
+    }
+    if (same) {
+        resCount++;
+    }
+    if (shorter) {
+        resCount++;
+    }
+    // A defender that combines goes straight back to attacking, and a reset stops it combining.
+    AgentContextInit(&a, FALSE, 7);
+    AgentContextSetCombinedTurns(&a, TRUE);
+    BB_Event sho = {BB_EVENT_SHO_RECEIVED, 2, 3, 0};
+    AgentContextRun(&a, ReceivedEvent(cha));
+    AgentContextSetState(&a, AGENT_STATE_DEFENDING);
+    Message reply = AgentContextRun(&a, sho);
+    if (reply.type == MESSAGE_RAS && reply.param1 == a.last_shot.row &&
+            reply.param2 == a.last_shot.col &&
+            AgentContextGetState(&a) == AGENT_STATE_ATTACKING) {
+        resCount++;
+    }
+    AgentContextRun(&a, reset);
+    AgentContextRun(&a, ReceivedEvent(cha));
+    AgentContextSetState(&a, AGENT_STATE_DEFENDING);
+    reply = AgentContextRun(&a, sho);
+    if (reply.type == MESSAGE_RES && AgentContextGetState(&a) == AGENT_STATE_WAITING_TO_SEND) {
+        resCount++;
+    }
+    if (resCount == 4) {
+        printf("PASSED: 4/4 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/4 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing AgentInit() and AgentSetState()\n");
+    AgentInit();
+    if (AgentGetState() == AGENT_STATE_START) {
+        resCount++;
+    }
+    AgentSetState(AGENT_STATE_DEFENDING);
+    if (AgentGetState() == AGENT_STATE_DEFENDING && AgentContextGetState(&a) != AGENT_STATE_DEFENDING) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
 
     return (EXIT_SUCCESS);
 }
-
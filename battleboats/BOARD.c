@@ -193,6 +193,67 @@ unsigned int BOARD_GetSysClock() {
     return SYSTEM_CLOCK;
 }
 
+/**
+ * Function: BOARD_DisableInterrupts(void)
+ * @param None
+ * @return The CP0 Status register from before the interrupts were masked
+ */
+uint32_t BOARD_DisableInterrupts(void) {
+#ifdef PIC32
+    uint32_t status;
+    asm volatile("di    %0" : "=r"(status));
+    asm volatile("ehb");
+    return status;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Function: BOARD_RestoreInterrupts(uint32_t state)
+ * @param state - the CP0 Status register returned by BOARD_DisableInterrupts()
+ * @return None
+ */
+void BOARD_RestoreInterrupts(uint32_t state) {
+#ifdef PIC32
+    if (state & _CP0_STATUS_IE_MASK) {
+        asm volatile("ei");
+    }
+#else
+    (void) state;
+#endif
+}
+
+/**
+ * Function: BOARD_WaitForInterrupt(void)
+ * @param None
+ * @return None
+ * @brief Executes WAIT.  OSCCONbits.SLPEN is clear out of reset, so the core enters Idle rather
+ * than Sleep: the CPU clock stops but PBCLK, and with it Timer2 and the UART, keeps running.  With
+ * interrupts disabled, a pending interrupt above the current IPL resumes execution after the WAIT
+ * without vectoring.
+ */
+void BOARD_WaitForInterrupt(void) {
+#ifdef PIC32
+    asm volatile("wait");
+#endif
+}
+
+/**
+ * Function: BOARD_GetCoreTimer(void)
+ * @param None
+ * @return The CP0 Count register
+ */
+uint32_t BOARD_GetCoreTimer(void) {
+#ifdef PIC32
+    uint32_t now;
+    asm volatile("mfc0   %0, $9" : "=r"(now));
+    return now;
+#else
+    return 0;
+#endif
+}
+
 /*******************************************************************************
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
@@ -50,6 +50,10 @@ enum {
 // Term.
 #define UART_BAUD_RATE 115200
 
+// The rate of the CP0 core timer read by BOARD_GetCoreTimer(), which counts at half the 80MHz
+// SYSCLK.
+#define BOARD_CORE_TICKS_PER_MS (80000000UL / 2000)
+
 /*
  * Set some helper macros for interfacing with the switches
  */
@@ -184,4 +188,40 @@ unsigned int BOARD_GetPBClock();
  */
 unsigned int BOARD_GetSysClock();
 
+/**
+ * Function: BOARD_DisableInterrupts(void)
+ * @param None
+ * @return The previous interrupt state, for BOARD_RestoreInterrupts()
+ * @brief Masks every interrupt until BOARD_RestoreInterrupts() is called.
+ */
+uint32_t BOARD_DisableInterrupts(void);
+
+/**
+ * Function: BOARD_RestoreInterrupts(uint32_t state)
+ * @param state - the value returned by the matching BOARD_DisableInterrupts()
+ * @return None
+ * @brief Unmasks interrupts again if they were enabled before BOARD_DisableInterrupts().
+ */
+void BOARD_RestoreInterrupts(uint32_t state);
+
+/**
+ * Function: BOARD_WaitForInterrupt(void)
+ * @param None
+ * @return None
+ * @brief Idles the CPU until an interrupt is requested.  Call it with interrupts disabled, after
+ * checking that there is nothing left to do: an interrupt requested in between still ends the
+ * wait at once, and its handler runs as soon as interrupts are restored.  The peripherals keep
+ * running while the CPU waits.
+ */
+void BOARD_WaitForInterrupt(void);
+
+/**
+ * Function: BOARD_GetCoreTimer(void)
+ * @param None
+ * @return The free-running CP0 core timer, BOARD_CORE_TICKS_PER_MS ticks per millisecond
+ * @brief Reads the core timer, the same counter DelayMs() in OledDriver.c reads.  It wraps every
+ * 107 seconds, so compare readings by unsigned subtraction.
+ */
+uint32_t BOARD_GetCoreTimer(void);
+
 #endif	/* BOARD_H */
@@ -23,6 +23,12 @@ typedef enum {
     BB_EVENT_SOUTH_BUTTON, //10
     BB_EVENT_EAST_BUTTON, //11
 
+    //capabilities are handled by the link, ahead of the agent (see Capability.h):
+    BB_EVENT_CAP_RECEIVED, //12
+
+    //a RES for the last SHO and a SHO in one message, once both boards agree to combine them:
+    BB_EVENT_RAS_RECEIVED, //13
+
 } BB_EventType;
 
 /**
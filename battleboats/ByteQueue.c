@@ -0,0 +1,126 @@
+/*
+ * File:   ByteQueue.c
+ *
+ * Single-producer, single-consumer byte queue. See ByteQueue.h.
+ */
+
+#include <string.h>
+#include "ByteQueue.h"
+#include "BOARD.h"
+
+// As in EventQueue.c, the index written by the other side is read with acquire ordering and our
+// own is published with release ordering, so copying the bytes can never be reordered past the
+// index update.
+#define BYTE_QUEUE_LOAD(index) __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define BYTE_QUEUE_STORE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+
+int ByteQueue_Init(ByteQueue *queue, uint8_t *storage, uint16_t size)
+{
+    if (size < 2 || size > 32768 || (size & (size - 1)) != 0) {
+        return STANDARD_ERROR;
+    }
+    queue->data = storage;
+    queue->mask = size - 1;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->overflows = 0;
+    return SUCCESS;
+}
+
+int ByteQueue_Write(ByteQueue *queue, const void *data, uint16_t size)
+{
+    uint16_t space, first, count = size;
+    uint8_t *span;
+
+    // Two spans at most: up to where the storage wraps, then from its start.
+    span = ByteQueue_GetWriteSpan(queue, &space);
+    first = (count < space) ? count : space;
+    memcpy(span, data, first);
+    ByteQueue_CommitWrite(queue, first);
+    count -= first;
+    if (count > 0) {
+        span = ByteQueue_GetWriteSpan(queue, &space);
+        if (count > space) {
+            queue->overflows += count - space;
+            count = space;
+        }
+        memcpy(span, (const uint8_t *) data + first, count);
+        ByteQueue_CommitWrite(queue, count);
+        if (first + count < size) {
+            return STANDARD_ERROR;
+        }
+    }
+    return SUCCESS;
+}
+
+int ByteQueue_WriteByte(ByteQueue *queue, uint8_t datum)
+{
+    uint32_t tail = queue->tail;
+
+    if (tail - BYTE_QUEUE_LOAD(queue->head) > queue->mask) {
+        queue->overflows++;
+        return STANDARD_ERROR;
+    }
+    queue->data[tail & queue->mask] = datum;
+    BYTE_QUEUE_STORE(queue->tail, tail + 1);
+    return SUCCESS;
+}
+
+uint8_t ByteQueue_ReadByte(ByteQueue *queue, uint8_t *datum)
+{
+    uint32_t head = queue->head;
+
+    if (head == BYTE_QUEUE_LOAD(queue->tail)) {
+        return FALSE;
+    }
+    *datum = queue->data[head & queue->mask];
+    BYTE_QUEUE_STORE(queue->head, head + 1);
+    return TRUE;
+}
+
+uint16_t ByteQueue_Count(const ByteQueue *queue)
+{
+    return BYTE_QUEUE_LOAD(queue->tail) - BYTE_QUEUE_LOAD(queue->head);
+}
+
+const uint8_t *ByteQueue_GetReadSpan(const ByteQueue *queue, uint16_t *size)
+{
+    uint32_t head = queue->head;
+    uint32_t waiting = BYTE_QUEUE_LOAD(queue->tail) - head;
+    uint32_t contiguous = queue->mask + 1 - (head & queue->mask);
+
+    *size = (waiting < contiguous) ? waiting : contiguous;
+    return &queue->data[head & queue->mask];
+}
+
+int ByteQueue_CommitRead(ByteQueue *queue, uint16_t size)
+{
+    uint32_t head = queue->head;
+
+    if (size > BYTE_QUEUE_LOAD(queue->tail) - head) {
+        return STANDARD_ERROR;
+    }
+    BYTE_QUEUE_STORE(queue->head, head + size);
+    return SUCCESS;
+}
+
+uint8_t *ByteQueue_GetWriteSpan(const ByteQueue *queue, uint16_t *size)
+{
+    uint32_t tail = queue->tail;
+    uint32_t space = queue->mask + 1 - (tail - BYTE_QUEUE_LOAD(queue->head));
+    uint32_t contiguous = queue->mask + 1 - (tail & queue->mask);
+
+    *size = (space < contiguous) ? space : contiguous;
+    return &queue->data[tail & queue->mask];
+}
+
+int ByteQueue_CommitWrite(ByteQueue *queue, uint16_t size)
+{
+    uint32_t tail = queue->tail;
+
+    if (size > queue->mask + 1 - (tail - BYTE_QUEUE_LOAD(queue->head))) {
+        return STANDARD_ERROR;
+    }
+    BYTE_QUEUE_STORE(queue->tail, tail + size);
+    return SUCCESS;
+}
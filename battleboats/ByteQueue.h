@@ -0,0 +1,93 @@
+#ifndef BYTE_QUEUE_H
+#define BYTE_QUEUE_H
+
+#include <stdint.h>
+
+/**
+ * A FIFO of bytes for exactly one producer and one consumer, such as a UART interrupt and the
+ * main loop. It is the CircularBuffer without its shared `dataSize`: CircularBuffer's producer
+ * increments that count and its consumer decrements it, so an interrupt landing between the
+ * other side's load and store loses an update. Here the producer only ever writes `tail` and the
+ * consumer only ever writes `head`. Both count bytes since ByteQueue_Init() and are never
+ * wrapped, so the length is always `tail - head`. Each side publishes its index only after the
+ * bytes it covers have been written or read, so neither side has to mask interrupts.
+ *
+ * Bytes written while the queue is full are dropped and counted in `overflows`.
+ *
+ * As with CircularBuffer, the span functions give direct access to the storage: the consumer
+ * reads the oldest bytes in place and the producer writes new ones in place, one contiguous run
+ * at a time.
+ */
+typedef struct {
+    uint8_t *data;
+    uint32_t mask;               // The size of `data`, a power of two, minus one.
+    volatile uint32_t head;      // Bytes read so far. Written by the consumer.
+    volatile uint32_t tail;      // Bytes written so far. Written by the producer.
+    volatile uint32_t overflows; // Written by the producer.
+} ByteQueue;
+
+/**
+ * Empties `queue` and points it at `size` bytes of `storage`. Call it before either side uses the
+ * queue.
+ *
+ * @return SUCCESS, or STANDARD_ERROR if `size` is not a power of two from 2 to 32768.
+ */
+int ByteQueue_Init(ByteQueue *queue, uint8_t *storage, uint16_t size);
+
+/**
+ * Adds `size` bytes to the back of `queue`. If they do not all fit, as many as fit are added and
+ * the rest are counted in `overflows`. Only the producer may call this.
+ *
+ * @return SUCCESS, or STANDARD_ERROR if any bytes were dropped.
+ */
+int ByteQueue_Write(ByteQueue *queue, const void *data, uint16_t size);
+
+/**
+ * Adds one byte to the back of `queue`. Only the producer may call this.
+ *
+ * @return SUCCESS, or STANDARD_ERROR if the queue was full and the byte was dropped.
+ */
+int ByteQueue_WriteByte(ByteQueue *queue, uint8_t datum);
+
+/**
+ * Removes the byte at the front of `queue` into `datum`. Only the consumer may call this.
+ *
+ * @return TRUE if a byte was removed, FALSE if the queue was empty.
+ */
+uint8_t ByteQueue_ReadByte(ByteQueue *queue, uint8_t *datum);
+
+/**
+ * Returns the number of bytes waiting. Exact for the consumer, a lower bound on the free space for
+ * the producer, and a snapshot for anyone else.
+ */
+uint16_t ByteQueue_Count(const ByteQueue *queue);
+
+/**
+ * Returns the oldest bytes in place, setting `size` to how many can be read from the returned
+ * pointer before the storage wraps (0 if the queue is empty). Only the consumer may call this;
+ * the bytes stay valid until it calls ByteQueue_CommitRead().
+ */
+const uint8_t *ByteQueue_GetReadSpan(const ByteQueue *queue, uint16_t *size);
+
+/**
+ * Removes `size` bytes read through ByteQueue_GetReadSpan(). Only the consumer may call this.
+ *
+ * @return SUCCESS, or STANDARD_ERROR if fewer than `size` bytes are waiting.
+ */
+int ByteQueue_CommitRead(ByteQueue *queue, uint16_t size);
+
+/**
+ * Returns the free space after the newest byte, setting `size` to how many bytes can be written
+ * from the returned pointer before the storage wraps (0 if the queue is full). Only the producer
+ * may call this; nothing written there is in the queue until ByteQueue_CommitWrite().
+ */
+uint8_t *ByteQueue_GetWriteSpan(const ByteQueue *queue, uint16_t *size);
+
+/**
+ * Adds `size` bytes written through ByteQueue_GetWriteSpan(). Only the producer may call this.
+ *
+ * @return SUCCESS, or STANDARD_ERROR if there is not room for `size` bytes.
+ */
+int ByteQueue_CommitWrite(ByteQueue *queue, uint16_t size);
+
+#endif // BYTE_QUEUE_H
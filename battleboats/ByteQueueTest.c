@@ -0,0 +1,202 @@
+/*
+ * File:   ByteQueueTest.c
+ *
+ * Tests for the SPSC byte queue. On the host a producer thread, standing in for the UART
+ * interrupt, and a consumer thread, standing in for the main loop, also hammer one queue; link
+ * with -pthread.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BOARD.h"
+#include "ByteQueue.h"
+
+#ifndef PIC32
+#include <pthread.h>
+#include <sched.h>
+
+#define STRESS_BYTES 4000000UL
+
+static ByteQueue stressQueue;
+static uint8_t stressStorage[64];
+
+/**
+ * Writes STRESS_BYTES bytes counting up from 0, mixing every way of writing in runs of 1 to 24
+ * bytes, and retrying whenever the queue is too full.
+ */
+static void *StressProducer(void *arg)
+{
+    uint32_t sent = 0, i;
+    uint8_t run[24];
+    (void) arg;
+    while (sent < STRESS_BYTES) {
+        uint16_t length = 1 + sent % 24, space;
+        uint8_t *span;
+        if (length > STRESS_BYTES - sent) {
+            length = STRESS_BYTES - sent;
+        }
+        switch (sent % 3) {
+        case 0:
+            if (ByteQueue_WriteByte(&stressQueue, sent) == SUCCESS) {
+                sent++;
+            }
+            break;
+        case 1:
+            // Only write runs that fit, so nothing counts as an overflow.
+            if (ByteQueue_Count(&stressQueue) + length <= sizeof (stressStorage)) {
+                for (i = 0; i < length; i++) {
+                    run[i] = sent + i;
+                }
+                ByteQueue_Write(&stressQueue, run, length);
+                sent += length;
+            }
+            break;
+        case 2:
+            span = ByteQueue_GetWriteSpan(&stressQueue, &space);
+            if (length > space) {
+                length = space;
+            }
+            for (i = 0; i < length; i++) {
+                span[i] = sent + i;
+            }
+            ByteQueue_CommitWrite(&stressQueue, length);
+            sent += length;
+            break;
+        }
+        sched_yield(); // Let the consumer run, even on a single CPU.
+    }
+    return NULL;
+}
+#endif
+
+int main(int argc, char** argv) {
+    BOARD_Init();
+    int resCount = 0;
+    int i;
+    ByteQueue queue;
+    uint8_t storage[16], datum;
+    const uint8_t *span;
+    uint8_t *writeSpan;
+    uint16_t size;
+    printf("Welcome to the ByteQueue.c Test!\n");
+
+    printf("Now Testing ByteQueue_Write() and ByteQueue_ReadByte()\n");
+    ByteQueue_Init(&queue, storage, sizeof (storage));
+    if (ByteQueue_ReadByte(&queue, &datum) == FALSE && ByteQueue_Count(&queue) == 0) {
+        resCount++;
+    }
+    ByteQueue_Write(&queue, "abc", 3);
+    ByteQueue_WriteByte(&queue, 'd');
+    uint8_t inOrder = ByteQueue_Count(&queue) == 4;
+    for (i = 0; i < 4; i++) {
+        if (!ByteQueue_ReadByte(&queue, &datum) || datum != "abcd"[i]) {
+            inOrder = FALSE;
+        }
+    }
+    if (inOrder && ByteQueue_ReadByte(&queue, &datum) == FALSE) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing sizes and overflow\n");
+    if (ByteQueue_Init(&queue, storage, 15) == STANDARD_ERROR &&
+            ByteQueue_Init(&queue, storage, 1) == STANDARD_ERROR) {
+        resCount++;
+    }
+    ByteQueue_Init(&queue, storage, sizeof (storage));
+    if (ByteQueue_Write(&queue, "0123456789ABCDEFGHIJ", 20) == STANDARD_ERROR &&
+            queue.overflows == 4 && ByteQueue_Count(&queue) == 16) {
+        resCount++;
+    }
+    // The newest bytes are the ones dropped.
+    if (ByteQueue_WriteByte(&queue, 'X') == STANDARD_ERROR && queue.overflows == 5 &&
+            ByteQueue_ReadByte(&queue, &datum) && datum == '0' &&
+            ByteQueue_WriteByte(&queue, 'X') == SUCCESS) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing spans and index wrap-around\n");
+    ByteQueue_Init(&queue, storage, sizeof (storage));
+    queue.head = queue.tail = UINT32_MAX - 12;
+    writeSpan = ByteQueue_GetWriteSpan(&queue, &size);
+    if (writeSpan == &storage[3] && size == 13) {
+        resCount++;
+    }
+    memcpy(writeSpan, "0123456789ABC", 13);
+    ByteQueue_CommitWrite(&queue, 13);
+    ByteQueue_Write(&queue, "DEF", 3);
+    span = ByteQueue_GetReadSpan(&queue, &size);
+    if (ByteQueue_CommitWrite(&queue, 1) == STANDARD_ERROR && queue.tail == 3 &&
+            span == &storage[3] && size == 13 && memcmp(span, "0123456789ABC", 13) == 0) {
+        resCount++;
+    }
+    ByteQueue_CommitRead(&queue, 13);
+    span = ByteQueue_GetReadSpan(&queue, &size);
+    if (span == storage && size == 3 && memcmp(span, "DEF", 3) == 0 &&
+            ByteQueue_CommitRead(&queue, 4) == STANDARD_ERROR &&
+            ByteQueue_CommitRead(&queue, 3) == SUCCESS && ByteQueue_Count(&queue) == 0) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+#ifndef PIC32
+    resCount = 0;
+    printf("Now Testing one producer and one consumer thread\n");
+    pthread_t producer;
+    uint32_t expected = 0;
+    uint8_t intact = TRUE;
+    ByteQueue_Init(&stressQueue, stressStorage, sizeof (stressStorage));
+    pthread_create(&producer, NULL, StressProducer, NULL);
+    while (expected < STRESS_BYTES) {
+        // Alternate between reading spans in place and reading a byte at a time.
+        if (expected & 1) {
+            span = ByteQueue_GetReadSpan(&stressQueue, &size);
+            for (i = 0; i < size; i++) {
+                if (span[i] != (uint8_t) (expected + i)) {
+                    intact = FALSE;
+                }
+            }
+            ByteQueue_CommitRead(&stressQueue, size);
+            expected += size;
+        } else if (ByteQueue_ReadByte(&stressQueue, &datum)) {
+            if (datum != (uint8_t) expected) {
+                intact = FALSE;
+            }
+            expected++;
+        }
+        if (ByteQueue_Count(&stressQueue) == 0) {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+    if (intact) {
+        resCount++;
+    }
+    if (ByteQueue_Count(&stressQueue) == 0 && stressQueue.overflows == 0) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+#endif
+
+    return (EXIT_SUCCESS);
+}
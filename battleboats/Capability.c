@@ -0,0 +1,64 @@
+/*
+ * File:   Capability.c
+ *
+ * Baud rates for the capabilities negotiated with a CAP message. See Capability.h.
+ */
+
+#include "Capability.h"
+#include "BOARD.h"
+
+/**
+ * The baud rate capabilities, slowest first.
+ */
+static const struct {
+    uint16_t capability;
+    uint32_t baudRate;
+} capabilityBaudRates[] = {
+    {CAPABILITY_BAUD_250000, 250000},
+    {CAPABILITY_BAUD_625000, 625000},
+    {CAPABILITY_BAUD_1250000, 1250000},
+};
+
+#define CAPABILITY_NUM_BAUD_RATES (sizeof (capabilityBaudRates) / sizeof (capabilityBaudRates[0]))
+
+/**
+ * Returns the index in capabilityBaudRates of the fastest rate in `capabilities`, or -1.
+ */
+static int Capability_FastestBaudRate(uint16_t capabilities)
+{
+    int i;
+    for (i = CAPABILITY_NUM_BAUD_RATES - 1; i >= 0; i--) {
+        if (capabilities & capabilityBaudRates[i].capability) {
+            break;
+        }
+    }
+    return i;
+}
+
+uint32_t Capability_BaudRate(uint16_t capabilities)
+{
+    int fastest = Capability_FastestBaudRate(capabilities);
+    return (fastest < 0) ? UART_BAUD_RATE : capabilityBaudRates[fastest].baudRate;
+}
+
+uint16_t Capability_BaudRateBrg(uint16_t capabilities)
+{
+    // The UART divides PBCLK by 16 * (U1BRG + 1), rounded to the nearest divisor as SERIAL_Init()
+    // does for UART_BAUD_RATE.
+    uint32_t baudRate = Capability_BaudRate(capabilities);
+    uint32_t clock = BOARD_GetPBClock() / 16;
+    return (uint16_t) ((clock + baudRate / 2) / baudRate - 1);
+}
+
+uint16_t Capability_DropBaudRate(uint16_t capabilities, uint16_t failed)
+{
+    int fastest = Capability_FastestBaudRate(failed);
+    int i;
+    if (fastest < 0) {
+        return capabilities;
+    }
+    for (i = fastest; i < (int) CAPABILITY_NUM_BAUD_RATES; i++) {
+        capabilities &= ~capabilityBaudRates[i].capability;
+    }
+    return capabilities;
+}
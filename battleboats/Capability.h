@@ -0,0 +1,67 @@
+#ifndef CAPABILITY_H
+#define CAPABILITY_H
+
+#include <stdint.h>
+
+/**
+ * Capabilities are optional protocol features that a board only uses once its opponent has said
+ * it supports them too. Each is one bit of a CAP message's capability set.
+ *
+ * Before a game, the challenger sends a CAP offer with every capability it supports. The accepter
+ * answers with a CAP answer holding the ones they share, and from the end of that answer both
+ * boards use them. An opponent that never answers is played with none.
+ *
+ * The baud rates are exact divisions of the 20MHz PBCLK: the standard PC rates above 115200
+ * (460800, 921600) are several percent off at any U1BRG value, which is more than a UART allows.
+ * Both boards derive the same clock from the same crystal frequency, so board-to-board links can
+ * run at any of these rates.
+ */
+#define CAPABILITY_BAUD_250000  0x0001
+#define CAPABILITY_BAUD_625000  0x0002
+#define CAPABILITY_BAUD_1250000 0x0004
+#define CAPABILITY_BAUDS (CAPABILITY_BAUD_250000 | CAPABILITY_BAUD_625000 | CAPABILITY_BAUD_1250000)
+
+/**
+ * Send every message but CAP as a binary frame instead of text (see MessageBinary.h).
+ */
+#define CAPABILITY_BINARY_FRAMES 0x0008
+
+/**
+ * Answer each SHO with a RAS, the RES and our next SHO in one message, instead of a RES and then
+ * a SHO (see AgentSetCombinedTurns()).
+ */
+#define CAPABILITY_COMBINED_TURNS 0x0010
+
+/**
+ * Everything this firmware supports.
+ */
+#define CAPABILITY_SUPPORTED \
+    (CAPABILITY_BAUDS | CAPABILITY_BINARY_FRAMES | CAPABILITY_COMBINED_TURNS)
+
+/**
+ * The second field of a CAP message: whether it is an offer or the answer to one.
+ */
+#define CAPABILITY_OFFER 0
+#define CAPABILITY_ANSWER 1
+
+/**
+ * Returns the fastest baud rate in `capabilities`, or UART_BAUD_RATE if it has none.
+ */
+uint32_t Capability_BaudRate(uint16_t capabilities);
+
+/**
+ * Returns the U1BRG value for Capability_BaudRate(capabilities), for Uart1ChangeBaudRate().
+ */
+uint16_t Capability_BaudRateBrg(uint16_t capabilities);
+
+/**
+ * Removes the fastest baud rate in `failed`, and every rate above it, from `capabilities`. A rate
+ * that has failed is not offered again.
+ *
+ * @param capabilities The capabilities this board offers.
+ * @param failed       The capabilities in use when the link failed.
+ * @return `capabilities` without the failed baud rate or any faster one.
+ */
+uint16_t Capability_DropBaudRate(uint16_t capabilities, uint16_t failed);
+
+#endif // CAPABILITY_H
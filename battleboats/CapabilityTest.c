@@ -0,0 +1,79 @@
+/*
+ * File:   CapabilityTest.c
+ *
+ * Tests for the baud rate capabilities in Capability.c.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "Capability.h"
+
+int main(int argc, char** argv) {
+    BOARD_Init();
+    int resCount = 0;
+    printf("Welcome to the Capability.c Test!\n");
+
+    printf("Now Testing Capability_BaudRate()\n");
+    if (Capability_BaudRate(0) == UART_BAUD_RATE) {
+        resCount++;
+    }
+    if (Capability_BaudRate(CAPABILITY_BAUDS) == 1250000) {
+        resCount++;
+    }
+    if (Capability_BaudRate(CAPABILITY_BAUD_250000 | CAPABILITY_BAUD_625000) == 625000) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Capability_BaudRateBrg()\n");
+    // The same U1BRG that SERIAL_Init() computes for the default rate.
+    if (Capability_BaudRateBrg(0) == 10) {
+        resCount++;
+    }
+    // Every negotiated rate divides the 20MHz PBCLK exactly.
+    if (Capability_BaudRateBrg(CAPABILITY_BAUD_250000) == 4 &&
+            BOARD_GetPBClock() / 16 / (4 + 1) == 250000) {
+        resCount++;
+    }
+    if (Capability_BaudRateBrg(CAPABILITY_BAUD_625000) == 1 &&
+            Capability_BaudRateBrg(CAPABILITY_BAUD_1250000) == 0) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Capability_DropBaudRate()\n");
+    if (Capability_DropBaudRate(CAPABILITY_BAUDS, CAPABILITY_BAUD_1250000) ==
+            (CAPABILITY_BAUD_250000 | CAPABILITY_BAUD_625000)) {
+        resCount++;
+    }
+    // Faster rates go too, even if they were not the one that failed.
+    if (Capability_DropBaudRate(CAPABILITY_BAUDS, CAPABILITY_BAUD_250000) == 0) {
+        resCount++;
+    }
+    if (Capability_DropBaudRate(CAPABILITY_BAUDS, 0) == CAPABILITY_BAUDS) {
+        resCount++;
+    }
+    // Capabilities other than baud rates are kept.
+    if (Capability_DropBaudRate(CAPABILITY_SUPPORTED, CAPABILITY_BAUD_250000) ==
+            (CAPABILITY_BINARY_FRAMES | CAPABILITY_COMBINED_TURNS)) {
+        resCount++;
+    }
+    if (resCount == 4) {
+        printf("PASSED: 4/4 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/4 TESTS PASSED\n", resCount);
+    }
+
+    return (EXIT_SUCCESS);
+}
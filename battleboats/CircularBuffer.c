@@ -218,8 +218,8 @@ int CB_PeekMany (const CircularBuffer *b, void *outData, uint16_t size)
 int CB_Remove(CircularBuffer *b, uint16_t size){
 	// If there are more elements in the buffer.
 	if (b->dataSize > size) {
-		// Checks to see if the buffer will wrap around.
-		if ((b->staticSize - b->readIndex) < size) {
+		// Checks to see if the buffer will wrap around, including landing exactly on the end.
+		if ((b->staticSize - b->readIndex) <= size) {
 			b-> readIndex = size - (b->staticSize - b->readIndex);
 		} else {
 			// If the buffer will not wrap around size is added to read index.
@@ -917,6 +917,14 @@ int main()
             assert(circBuf.writeIndex == 7);
 
             assert(!memcmp(testIn, testOut, 20));
+
+            //Test removing exactly up to the end of the storage, with data left after the wrap
+            CB_WriteMany(&circBuf, testIn, 16, TRUE);
+            assert(circBuf.writeIndex == 3);
+            CB_Remove(&circBuf, 13);
+            assert(circBuf.readIndex == 0);
+            assert(circBuf.dataSize == 3);
+            CB_Remove(&circBuf, 3);
         }
 
 	printf("All tests passed.\n");
@@ -27,6 +27,10 @@
  *
  * Unit testing has been completed on x86 by compiling with the UNIT_TEST_CIRCULAR_BUFFER macro.
  * With gcc: `gcc CircularBuffer.c -DUNIT_TEST_CIRCULAR_BUFFER`
+ *
+ * The writer and the reader both update `dataSize`, so a buffer shared between an interrupt and
+ * the main code needs interrupts masked around every call. ByteQueue.h is the lock-free variant
+ * for that case, with power-of-two masking and in-place spans; the UART uses it.
  */
 #ifndef CIRCULAR_BUFFER_H
 #define CIRCULAR_BUFFER_H
@@ -0,0 +1,54 @@
+/*
+ * File:   EventQueue.c
+ *
+ * Single-producer, single-consumer BB_Event queue. See EventQueue.h.
+ */
+
+#include <string.h>
+#include "EventQueue.h"
+#include "BOARD.h"
+
+// The index written by the other side is read with acquire ordering, and our own is published
+// with release ordering, so the event copy can never be reordered past the index update. On the
+// PIC32 these are ordinary loads and stores around a `sync`.
+#define EVENT_QUEUE_LOAD(index) __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define EVENT_QUEUE_STORE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+
+void EventQueue_Init(EventQueue *queue)
+{
+    memset(queue, 0, sizeof (*queue));
+}
+
+int EventQueue_Push(EventQueue *queue, const BB_Event *event)
+{
+    uint32_t tail = queue->tail;
+    uint32_t waiting = tail - EVENT_QUEUE_LOAD(queue->head);
+
+    if (waiting == EVENT_QUEUE_SIZE) {
+        queue->overflows++;
+        return STANDARD_ERROR;
+    }
+    queue->events[tail % EVENT_QUEUE_SIZE] = *event;
+    EVENT_QUEUE_STORE(queue->tail, tail + 1);
+    if (waiting + 1 > queue->highWater) {
+        queue->highWater = waiting + 1;
+    }
+    return SUCCESS;
+}
+
+uint8_t EventQueue_Pop(EventQueue *queue, BB_Event *event)
+{
+    uint32_t head = queue->head;
+
+    if (head == EVENT_QUEUE_LOAD(queue->tail)) {
+        return FALSE;
+    }
+    *event = queue->events[head % EVENT_QUEUE_SIZE];
+    EVENT_QUEUE_STORE(queue->head, head + 1);
+    return TRUE;
+}
+
+uint32_t EventQueue_Count(const EventQueue *queue)
+{
+    return EVENT_QUEUE_LOAD(queue->tail) - EVENT_QUEUE_LOAD(queue->head);
+}
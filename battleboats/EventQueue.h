@@ -0,0 +1,52 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stdint.h>
+#include "BattleBoats.h"
+
+/**
+ * A fixed-size FIFO of BB_Events for exactly one producer and one consumer, e.g. an interrupt
+ * handler and the main loop. It needs no locks and never masks interrupts: the producer only
+ * ever writes `tail` and the consumer only ever writes `head`, and each publishes its index only
+ * after the event it covers has been written or read.
+ *
+ * Every producer gets its own queue, so two interrupts can never race for a slot.
+ *
+ * If the queue is full the new event is dropped and counted in `overflows`. `highWater` records
+ * the most events ever waiting at once, to show how close a queue has come to overflowing.
+ */
+#define EVENT_QUEUE_SIZE 16 // Must be a power of two.
+
+typedef struct {
+    BB_Event events[EVENT_QUEUE_SIZE];
+    volatile uint32_t head;      // Events taken so far. Written by the consumer.
+    volatile uint32_t tail;      // Events added so far. Written by the producer.
+    volatile uint32_t overflows; // Written by the producer.
+    volatile uint32_t highWater; // Written by the producer.
+} EventQueue;
+
+/**
+ * Empties `queue` and clears its counters. Call it before either side uses the queue.
+ */
+void EventQueue_Init(EventQueue *queue);
+
+/**
+ * Adds a copy of `event` to the back of `queue`. Only the producer may call this.
+ *
+ * @return SUCCESS, or STANDARD_ERROR if the queue was full and the event was dropped.
+ */
+int EventQueue_Push(EventQueue *queue, const BB_Event *event);
+
+/**
+ * Removes the event at the front of `queue` into `event`. Only the consumer may call this.
+ *
+ * @return TRUE if an event was removed, FALSE if the queue was empty.
+ */
+uint8_t EventQueue_Pop(EventQueue *queue, BB_Event *event);
+
+/**
+ * Returns the number of events waiting. Exact for the consumer; a snapshot for anyone else.
+ */
+uint32_t EventQueue_Count(const EventQueue *queue);
+
+#endif // EVENT_QUEUE_H
@@ -0,0 +1,148 @@
+/*
+ * File:   EventQueueTest.c
+ *
+ * Tests for the SPSC event queue. On the host a producer and a consumer thread also hammer one
+ * queue; link with -pthread.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "EventQueue.h"
+
+#ifndef PIC32
+#include <pthread.h>
+#include <sched.h>
+
+#define STRESS_EVENTS 1000000UL
+
+static EventQueue stressQueue;
+
+/**
+ * Pushes STRESS_EVENTS numbered events, retrying whenever the queue is full.
+ */
+static void *StressProducer(void *arg)
+{
+    uint32_t i;
+    (void) arg;
+    for (i = 0; i < STRESS_EVENTS; i++) {
+        BB_Event event = {BB_EVENT_SHO_RECEIVED, i & 0xFFFF, i >> 16, ~i & 0xFFFF};
+        while (EventQueue_Push(&stressQueue, &event) != SUCCESS) {
+            sched_yield(); // Let the consumer run, even on a single CPU.
+        }
+    }
+    return NULL;
+}
+#endif
+
+int main(int argc, char** argv) {
+    BOARD_Init();
+    int resCount = 0;
+    int i;
+    EventQueue queue;
+    BB_Event event = {BB_EVENT_START_BUTTON, 0, 0, 0};
+    printf("Welcome to the EventQueue.c Test!\n");
+
+    printf("Now Testing EventQueue_Push() and EventQueue_Pop()\n");
+    EventQueue_Init(&queue);
+    if (EventQueue_Pop(&queue, &event) == FALSE && EventQueue_Count(&queue) == 0) {
+        resCount++;
+    }
+    for (i = 0; i < 3; i++) {
+        event.param0 = i;
+        EventQueue_Push(&queue, &event);
+    }
+    uint8_t inOrder = EventQueue_Count(&queue) == 3;
+    for (i = 0; i < 3; i++) {
+        if (!EventQueue_Pop(&queue, &event) || event.param0 != i ||
+                event.type != BB_EVENT_START_BUTTON) {
+            inOrder = FALSE;
+        }
+    }
+    if (inOrder && EventQueue_Pop(&queue, &event) == FALSE) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing overflow and high-water counters\n");
+    EventQueue_Init(&queue);
+    for (i = 0; i < EVENT_QUEUE_SIZE + 3; i++) {
+        event.param0 = i;
+        EventQueue_Push(&queue, &event);
+    }
+    if (queue.overflows == 3 && queue.highWater == EVENT_QUEUE_SIZE) {
+        resCount++;
+    }
+    // The newest events are the ones dropped.
+    EventQueue_Pop(&queue, &event);
+    if (event.param0 == 0 && EventQueue_Push(&queue, &event) == SUCCESS) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing index wrap-around\n");
+    EventQueue_Init(&queue);
+    queue.head = queue.tail = UINT32_MAX - 2;
+    uint8_t wrapped = TRUE;
+    for (i = 0; i < 8; i++) {
+        event.param0 = i;
+        if (EventQueue_Push(&queue, &event) != SUCCESS || EventQueue_Count(&queue) != 1 ||
+                !EventQueue_Pop(&queue, &event) || event.param0 != i) {
+            wrapped = FALSE;
+        }
+    }
+    if (wrapped && queue.overflows == 0) {
+        resCount++;
+    }
+    if (resCount == 1) {
+        printf("PASSED: 1/1 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/1 TESTS PASSED\n", resCount);
+    }
+
+#ifndef PIC32
+    resCount = 0;
+    printf("Now Testing one producer and one consumer thread\n");
+    pthread_t producer;
+    uint32_t expected = 0;
+    uint8_t intact = TRUE;
+    EventQueue_Init(&stressQueue);
+    pthread_create(&producer, NULL, StressProducer, NULL);
+    while (expected < STRESS_EVENTS) {
+        if (!EventQueue_Pop(&stressQueue, &event)) {
+            sched_yield();
+            continue;
+        }
+        if (event.param0 != (expected & 0xFFFF) || event.param1 != (expected >> 16) ||
+                event.param2 != (~expected & 0xFFFF)) {
+            intact = FALSE;
+        }
+        expected++;
+    }
+    pthread_join(producer, NULL);
+    if (intact) {
+        resCount++;
+    }
+    if (EventQueue_Count(&stressQueue) == 0) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED (high water %lu)\n",
+                (unsigned long) stressQueue.highWater);
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+#endif
+
+    return (EXIT_SUCCESS);
+}
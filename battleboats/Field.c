@@ -8,8 +8,60 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "Field.h"
-#include "Board.h"
+#include "FieldPlacement.h"
+#include "BOARD.h"
 #include "FieldOled.h"
+
+/**
+ * Returns the mask of every square that holds something other than FIELD_SQUARE_EMPTY.
+ */
+static FieldMask FieldOccupied(const Field *f)
+{
+    FieldMask occupied = FieldMaskOr(FieldMaskOr(f->unknown, f->hit), FieldMaskOr(f->miss, f->cursor));
+    int i;
+    for (i = 0; i < FIELD_NUM_BOATS; i++) {
+        occupied = FieldMaskOr(occupied, f->boats[i]);
+    }
+    return occupied;
+}
+
+/**
+ * Counts the SMALL placements that fit alongside the squares in `taken`.
+ */
+static uint32_t FieldCountSmallFits(const FieldMask *taken)
+{
+    uint32_t count = 0;
+    int s;
+    for (s = fieldPlacementStart[FIELD_BOAT_TYPE_SMALL]; s < fieldPlacementStart[FIELD_BOAT_TYPE_SMALL + 1]; s++) {
+        if (!FieldMaskIntersects(&fieldPlacements[s].mask, taken)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Returns the squares known to be empty: those that were shot and turned out not to be hits.
+ */
+static FieldMask FieldKnownEmpty(const Field *opp_field)
+{
+    return FieldMaskAndNot(FieldMaskAndNot(FieldMaskAll(), opp_field->unknown), opp_field->hit);
+}
+
+/**
+ * Returns the squares of the boats that have been pinned down after being sunk.
+ */
+static FieldMask FieldResolvedBoats(const Field *opp_field)
+{
+    FieldMask resolved;
+    int i;
+    FieldMaskClear(&resolved);
+    for (i = 0; i < FIELD_NUM_BOATS; i++) {
+        resolved = FieldMaskOr(resolved, opp_field->boats[i]);
+    }
+    return resolved;
+}
+
 /*
  * .
  */
@@ -19,15 +71,14 @@ void FieldPrint_UART(Field *own_field, Field * opp_field) {
     //for loop to print ith and jth rows
     for (i = 0; i < FIELD_ROWS; i++) {
         for (j = 0; j < FIELD_COLS; j++) {
-            if (own_field->grid[i][j] == FIELD_SQUARE_EMPTY) {
+            SquareStatus status = FieldGetSquareStatus(own_field, i, j);
+            if (status == FIELD_SQUARE_EMPTY) {
                 printf(" [ ]");
-               
-            } else if (own_field->grid[i][j] == FIELD_SQUARE_UNKNOWN) {
+            } else if (status == FIELD_SQUARE_UNKNOWN) {
                 printf(" [|]");
-            } else if (own_field->grid[i][j] == FIELD_SQUARE_HIT) {
+            } else if (status == FIELD_SQUARE_HIT) {
                 printf(" [x]");
-                
-            } else if (own_field->grid[i][j] == FIELD_SQUARE_MISS) {
+            } else if (status == FIELD_SQUARE_MISS) {
                 printf(" [M]");
             }
             else {
@@ -39,10 +90,13 @@ void FieldPrint_UART(Field *own_field, Field * opp_field) {
     printf("\n");
     for (i = 0; i < FIELD_ROWS; i++) {
         for (j = 0; j < FIELD_COLS; j++) {
-            if (opp_field->grid[i][j] == FIELD_SQUARE_EMPTY) {
+            SquareStatus status = FieldGetSquareStatus(opp_field, i, j);
+            if (status == FIELD_SQUARE_EMPTY) {
                 printf(" [ ]");
-            } else if (opp_field->grid[i][j] == FIELD_SQUARE_UNKNOWN) {
+            } else if (status == FIELD_SQUARE_UNKNOWN) {
                 printf(" [|]");
+            } else if (status == FIELD_SQUARE_HIT) {
+                printf(" [x]");
             }
         }
         printf("\n");
@@ -52,8 +106,8 @@ void FieldPrint_UART(Field *own_field, Field * opp_field) {
  * FieldInit() will initialize two passed field structs for the beginning of play.
  * Each field's grid should be filled with the appropriate SquareStatus (
  * FIELD_SQUARE_EMPTY for your own field, FIELD_SQUARE_UNKNOWN for opponent's).
- * Additionally, your opponent's field's boatLives parameters should be filled
- *  (your own field's boatLives will be filled when boats are added)
+ * Additionally, your opponent's field's aliveBoats flags should be filled
+ *  (your own field's aliveBoats will be filled when boats are added)
  * 
  * FieldAI_PlaceAllBoats() should NOT be called in this function.
  * 
@@ -61,21 +115,24 @@ void FieldPrint_UART(Field *own_field, Field * opp_field) {
  * @param opp_field     //A field representing the opponent's ships
  */
 void FieldInit(Field *own_field, Field * opp_field) {
-    int i, j;
-    for (i = 0; i < FIELD_ROWS; i++) {
-        for (j = 0; j < FIELD_COLS; j++) {
-            own_field->grid[i][j] = FIELD_SQUARE_EMPTY;
-        }
-    }
-    for (i = 0; i < FIELD_ROWS; i++) {
-        for (j = 0; j < FIELD_COLS; j++) {
-            opp_field->grid[i][j] = FIELD_SQUARE_UNKNOWN;
-        }
+    int i;
+    FieldMaskClear(&own_field->unknown);
+    FieldMaskClear(&own_field->hit);
+    FieldMaskClear(&own_field->miss);
+    FieldMaskClear(&own_field->cursor);
+    own_field->aliveBoats = 0;
+
+    opp_field->unknown = FieldMaskAll();
+    FieldMaskClear(&opp_field->hit);
+    FieldMaskClear(&opp_field->miss);
+    FieldMaskClear(&opp_field->cursor);
+    opp_field->aliveBoats = FIELD_BOAT_STATUS_SMALL | FIELD_BOAT_STATUS_MEDIUM |
+            FIELD_BOAT_STATUS_LARGE | FIELD_BOAT_STATUS_HUGE;
+
+    for (i = 0; i < FIELD_NUM_BOATS; i++) {
+        FieldMaskClear(&own_field->boats[i]);
+        FieldMaskClear(&opp_field->boats[i]);
     }
-    opp_field->smallBoatLives = FIELD_BOAT_SIZE_SMALL;
-    opp_field->mediumBoatLives = FIELD_BOAT_SIZE_MEDIUM;
-    opp_field->largeBoatLives = FIELD_BOAT_SIZE_LARGE;
-    opp_field->hugeBoatLives = FIELD_BOAT_SIZE_HUGE;
 }
 /**
  * Retrieves the value at the specified field position.
@@ -86,14 +143,29 @@ void FieldInit(Field *own_field, Field * opp_field) {
  *          Otherwise, return the status of the referenced square 
  */
 SquareStatus FieldGetSquareStatus(const Field *f, uint8_t row, uint8_t col) {
-    if ((row > FIELD_ROWS) || (col > FIELD_COLS)) {
+    if ((row >= FIELD_ROWS) || (col >= FIELD_COLS)) {
         return FIELD_SQUARE_INVALID;
     }
-    if ((row < 0) || (col < 0)) {
-        return FIELD_SQUARE_INVALID;
+    uint16_t square = FieldSquareIndex(row, col);
+    int i;
+    if (FieldMaskTest(&f->cursor, square)) {
+        return FIELD_SQUARE_CURSOR;
     }
-    return f->grid[row][col];
-    
+    if (FieldMaskTest(&f->hit, square)) {
+        return FIELD_SQUARE_HIT;
+    }
+    if (FieldMaskTest(&f->miss, square)) {
+        return FIELD_SQUARE_MISS;
+    }
+    for (i = 0; i < FIELD_NUM_BOATS; i++) {
+        if (FieldMaskTest(&f->boats[i], square)) {
+            return FIELD_SQUARE_SMALL_BOAT + i;
+        }
+    }
+    if (FieldMaskTest(&f->unknown, square)) {
+        return FIELD_SQUARE_UNKNOWN;
+    }
+    return FIELD_SQUARE_EMPTY;
 }
 /**
  * This function provides an interface for setting individual locations within a Field struct. This
@@ -107,8 +179,42 @@ SquareStatus FieldGetSquareStatus(const Field *f, uint8_t row, uint8_t col) {
  * @return The old value at that field location
  */
 SquareStatus FieldSetSquareStatus(Field *f, uint8_t row, uint8_t col, SquareStatus p) {
-    SquareStatus status = f->grid[row][col];
-    f->grid[row][col] = p;
+    SquareStatus status = FieldGetSquareStatus(f, row, col);
+    if (status == FIELD_SQUARE_INVALID) {
+        return status;
+    }
+    uint16_t square = FieldSquareIndex(row, col);
+    int i;
+    // Clear the square out of every mask before adding it to the one for its new status.
+    FieldMaskReset(&f->unknown, square);
+    FieldMaskReset(&f->hit, square);
+    FieldMaskReset(&f->miss, square);
+    FieldMaskReset(&f->cursor, square);
+    for (i = 0; i < FIELD_NUM_BOATS; i++) {
+        FieldMaskReset(&f->boats[i], square);
+    }
+    switch (p) {
+        case FIELD_SQUARE_SMALL_BOAT:
+        case FIELD_SQUARE_MEDIUM_BOAT:
+        case FIELD_SQUARE_LARGE_BOAT:
+        case FIELD_SQUARE_HUGE_BOAT:
+            FieldMaskSet(&f->boats[p - FIELD_SQUARE_SMALL_BOAT], square);
+            break;
+        case FIELD_SQUARE_UNKNOWN:
+            FieldMaskSet(&f->unknown, square);
+            break;
+        case FIELD_SQUARE_HIT:
+            FieldMaskSet(&f->hit, square);
+            break;
+        case FIELD_SQUARE_MISS:
+            FieldMaskSet(&f->miss, square);
+            break;
+        case FIELD_SQUARE_CURSOR:
+            FieldMaskSet(&f->cursor, square);
+            break;
+        default:
+            break;
+    }
     return status;
 }
 /**
@@ -122,7 +228,7 @@ SquareStatus FieldSetSquareStatus(Field *f, uint8_t row, uint8_t col, SquareStat
  * field is unmodified and STANDARD_ERROR is returned. There is no hard-coded limit to how many
  * times a boat can be added to a field within this function.
  * 
- * In addition, this function should update the appropriate boatLives parameter of the field.
+ * In addition, this function should set the boat's flag in the field's aliveBoats.
  *
  * So this is valid test code:
  * {
@@ -153,81 +259,17 @@ SquareStatus FieldSetSquareStatus(Field *f, uint8_t row, uint8_t col, SquareStat
  * @return SUCCESS for success, STANDARD_ERROR for failure
  */
 uint8_t FieldAddBoat(Field *own_field, uint8_t row, uint8_t col, BoatDirection dir, BoatType boat_type) {
-    if ((row >= FIELD_ROWS) || (col >= FIELD_COLS)) {
-        return STANDARD_ERROR;
-    }
-    if ((row < 0) || (col < 0)) {
-        return STANDARD_ERROR;
-    }
-    int boatLength = 0;
-    SquareStatus boatType;
-    if (boat_type == FIELD_BOAT_TYPE_SMALL) {
-        boatLength = FIELD_BOAT_SIZE_SMALL;
-        boatType = FIELD_SQUARE_SMALL_BOAT;
-    }
-    else if (boat_type == FIELD_BOAT_TYPE_MEDIUM) {
-        boatLength = FIELD_BOAT_SIZE_MEDIUM;
-        boatType = FIELD_SQUARE_MEDIUM_BOAT;
-    }
-    else if (boat_type == FIELD_BOAT_TYPE_LARGE) {
-        boatLength = FIELD_BOAT_SIZE_LARGE;
-        boatType = FIELD_SQUARE_LARGE_BOAT;
-    }
-    else if (boat_type == FIELD_BOAT_TYPE_HUGE)
-    {
-        boatLength = FIELD_BOAT_SIZE_HUGE;
-        boatType = FIELD_SQUARE_HUGE_BOAT;
-    }
-    
-    if (dir == FIELD_DIR_EAST) {
-        if (col + boatLength - 1 >= FIELD_COLS) {
-            return STANDARD_ERROR;
-        }
-        for (int i = 0; i < boatLength; i++) {
-            if (own_field->grid[row][col + i] != FIELD_SQUARE_EMPTY) {
-                return STANDARD_ERROR;
-            }
-        }
-        for (int i = 0; i < (boatLength); i++) {
-            own_field->grid[row][col + i] = boatType;
-        }
-    }
-    else if (dir == FIELD_DIR_SOUTH) {
-        if (row + boatLength - 1 >= FIELD_ROWS) {
-            return STANDARD_ERROR;
-        }
-        for (int i = 0; i < boatLength; i++) {
-            if (own_field->grid[row + i][col] != FIELD_SQUARE_EMPTY) {
-                return STANDARD_ERROR;
-            }
-        }
-        for (int i = 0; i < (boatLength); i++) {
-            own_field->grid[row + i][col] = boatType;
-        }
-    }
-    else {
+    int placement = FieldPlacementFind(boat_type, row, col, dir);
+    if (placement < 0) {
         return STANDARD_ERROR;
     }
-    switch (boatType) {
-        case FIELD_BOAT_TYPE_SMALL:
-            own_field->smallBoatLives = FIELD_BOAT_SIZE_SMALL;
-            break;
-        case FIELD_BOAT_TYPE_MEDIUM:
-            own_field->mediumBoatLives = FIELD_BOAT_SIZE_MEDIUM;
-            break;
-        case FIELD_BOAT_TYPE_LARGE:
-            own_field->largeBoatLives = FIELD_BOAT_SIZE_LARGE;
-            break;
-        case FIELD_BOAT_TYPE_HUGE:
-            own_field->hugeBoatLives = FIELD_BOAT_SIZE_HUGE;
-            break;
-    }
-    if (boat_type == FIELD_BOAT_TYPE_SMALL || boat_type == FIELD_BOAT_SIZE_MEDIUM || boat_type == FIELD_BOAT_TYPE_LARGE || boat_type == FIELD_BOAT_TYPE_HUGE) {
-        ;
-    }
-    else {
+    const FieldMask *boat = &fieldPlacements[placement].mask;
+    FieldMask occupied = FieldOccupied(own_field);
+    if (FieldMaskIntersects(boat, &occupied)) {
         return STANDARD_ERROR;
     }
+    own_field->boats[boat_type] = FieldMaskOr(own_field->boats[boat_type], *boat);
+    own_field->aliveBoats |= (1 << boat_type);
     return SUCCESS;
 }
 /**
@@ -245,59 +287,63 @@ SquareStatus FieldRegisterEnemyAttack(Field *own_field, GuessData *opp_guess) {
     uint8_t col = opp_guess->col;
     uint8_t row = opp_guess->row;
     SquareStatus squareStatus = FieldGetSquareStatus(own_field, row, col);
-    if (squareStatus != FIELD_SQUARE_EMPTY && squareStatus != FIELD_SQUARE_HIT && squareStatus != FIELD_SQUARE_MISS) {
-        own_field->grid[row][col] == FIELD_SQUARE_HIT;
-        switch (squareStatus) {
-            case FIELD_SQUARE_SMALL_BOAT:
-                if ((own_field->smallBoatLives - 1) == 0) {
-                    own_field->smallBoatLives -= 1;
-                    opp_guess->result = RESULT_SMALL_BOAT_SUNK;
-                }
-                else {
-                    own_field->smallBoatLives -= 1;
-                    opp_guess->result = RESULT_HIT;
-                }
-                break;
-            case FIELD_SQUARE_MEDIUM_BOAT:
-                if ((own_field->mediumBoatLives - 1) == 0) {
-                    own_field->mediumBoatLives -= 1;
-                    opp_guess->result = RESULT_MEDIUM_BOAT_SUNK;
-                }
-                else {
-                    own_field->mediumBoatLives -= 1;
-                    opp_guess->result = RESULT_HIT;
-                }
-                break;
-            case FIELD_SQUARE_LARGE_BOAT:
-                if ((own_field->largeBoatLives - 1) == 0) {
-                    own_field->largeBoatLives -= 1;
-                    opp_guess->result = RESULT_LARGE_BOAT_SUNK;
-                }
-                else {
-                    own_field->largeBoatLives -= 1;
-                    opp_guess->result = RESULT_HIT;
-                }
-                break;
-            case FIELD_SQUARE_HUGE_BOAT:
-                if ((own_field->hugeBoatLives - 1) == 0) {
-                    own_field->hugeBoatLives -= 1;
-                    opp_guess->result = RESULT_HUGE_BOAT_SUNK;
-                }
-                else {
-                    own_field->hugeBoatLives -= 1;
-                    opp_guess->result = RESULT_HIT;
-                }
-                break;
-        }   
-    }
-    else if (own_field->grid[row][col] == FIELD_SQUARE_EMPTY) {
-        own_field->grid[row][col] == FIELD_SQUARE_MISS;
-        opp_guess->result = RESULT_MISS;
-    }
-    return squareStatus;    
+    opp_guess->result = RESULT_MISS;
+    if (squareStatus == FIELD_SQUARE_INVALID) {
+        return squareStatus;
+    }
+    uint16_t square = FieldSquareIndex(row, col);
+    int i;
+    if (FieldMaskTest(&own_field->hit, square)) {
+        // This square was already hit, so there is nothing more to damage.
+        opp_guess->result = RESULT_HIT;
+        return squareStatus;
     }
+    for (i = 0; i < FIELD_NUM_BOATS; i++) {
+        if (FieldMaskTest(&own_field->boats[i], square)) {
+            FieldMaskSet(&own_field->hit, square);
+            // The boat is sunk once none of its squares are left unhit.
+            FieldMask afloat = FieldMaskAndNot(own_field->boats[i], own_field->hit);
+            if (FieldMaskIsEmpty(&afloat)) {
+                own_field->aliveBoats &= ~(1 << i);
+                opp_guess->result = RESULT_SMALL_BOAT_SUNK + i;
+            } else {
+                opp_guess->result = RESULT_HIT;
+            }
+            return squareStatus;
+        }
+    }
+    FieldMaskSet(&own_field->miss, square);
+    return squareStatus;
+}
     
    
+/**
+ * After a boat of `type` is sunk by a shot at `square`, its position is known if exactly one of
+ * its placements covers that square and lies entirely on unclaimed hits. The boat is then
+ * recorded in opp_field->boats so the AI stops treating those hits as leads.
+ */
+static void FieldPinSunkBoat(Field *opp_field, BoatType type, uint16_t square)
+{
+    FieldMask claimed = FieldResolvedBoats(opp_field);
+    const FieldMask *found = NULL;
+    int p;
+    for (p = fieldPlacementStart[type]; p < fieldPlacementStart[type + 1]; p++) {
+        const FieldMask *mask = &fieldPlacements[p].mask;
+        FieldMask unhit = FieldMaskAndNot(*mask, opp_field->hit);
+        if (!FieldMaskTest(mask, square) || !FieldMaskIsEmpty(&unhit) ||
+                FieldMaskIntersects(mask, &claimed)) {
+            continue;
+        }
+        if (found) {
+            return; // Ambiguous, so leave it unpinned.
+        }
+        found = mask;
+    }
+    if (found) {
+        opp_field->boats[type] = *found;
+    }
+}
+
 /**
  * This function updates the FieldState representing the opponent's game board with whether the
  * guess indicated within gData was a hit or not. If it was a hit, then the field is updated with a
@@ -315,28 +361,25 @@ SquareStatus FieldUpdateKnowledge(Field *opp_field, const GuessData *own_guess)
     int col = own_guess->col;
     int row = own_guess->row;
     SquareStatus squareStatus = FieldGetSquareStatus(opp_field, row, col);
+    if (squareStatus == FIELD_SQUARE_INVALID) {
+        return squareStatus;
+    }
+    uint16_t square = FieldSquareIndex(row, col);
+    FieldMaskReset(&opp_field->unknown, square);
     switch (own_guess->result) {
         case RESULT_HIT:
-            opp_field->grid[row][col] = FIELD_SQUARE_HIT;
+            FieldMaskSet(&opp_field->hit, square);
             break;
         case RESULT_SMALL_BOAT_SUNK:
-            opp_field->grid[row][col] = FIELD_SQUARE_HIT;
-            opp_field->smallBoatLives = 0;
-            break;
         case RESULT_MEDIUM_BOAT_SUNK:
-            opp_field->grid[row][col] = FIELD_SQUARE_HIT;
-            opp_field->mediumBoatLives = 0;
-            break;
         case RESULT_LARGE_BOAT_SUNK:
-            opp_field->grid[row][col] = FIELD_SQUARE_HIT;
-            opp_field->largeBoatLives = 0;
-            break;
         case RESULT_HUGE_BOAT_SUNK:
-            opp_field->grid[row][col] = FIELD_SQUARE_HIT;
-            opp_field->hugeBoatLives = 0;
+            FieldMaskSet(&opp_field->hit, square);
+            opp_field->aliveBoats &= ~(1 << (own_guess->result - RESULT_SMALL_BOAT_SUNK));
+            FieldPinSunkBoat(opp_field, own_guess->result - RESULT_SMALL_BOAT_SUNK, square);
             break;
         case RESULT_MISS:
-            opp_field->grid[row][col] = FIELD_SQUARE_EMPTY;
+            // A known miss reads back as FIELD_SQUARE_EMPTY, which clearing `unknown` gives us.
             break;
     }
     return squareStatus;
@@ -350,72 +393,68 @@ SquareStatus FieldUpdateKnowledge(Field *opp_field, const GuessData *own_guess)
  * @return A 4-bit value with each bit corresponding to whether each ship is alive or not.
  */
 uint8_t FieldGetBoatStates(const Field *f) {
-    uint8_t boatStates = 0;
-    if (f->smallBoatLives > 0) {
-        boatStates |= FIELD_BOAT_STATUS_SMALL;
-    }
-    if (f->mediumBoatLives > 0) {
-        boatStates |= FIELD_BOAT_STATUS_MEDIUM;
+    return f->aliveBoats;
+}
+
+uint8_t FieldAIPlaceAllBoats(Field *own_field) {
+    return FieldAIPlaceAllBoatsWith(own_field, &randomDefault);
+}
+
+uint8_t FieldAIPlaceAllBoatsWith(Field *own_field, RandomState *rng) {
+    // The fleet is sampled uniformly from all fieldFleetTotal fleets, one boat at a time. Each
+    // boat's placement is chosen with probability proportional to the number of fleets that
+    // complete it, so no choice ever has to be retried. The HUGE and LARGE weights come from the
+    // precomputed tables; the MEDIUM weights are counted here in at most
+    // (MEDIUM placements x SMALL placements) mask tests.
+    FieldMask occupied = FieldOccupied(own_field);
+    if (!FieldMaskIsEmpty(&occupied)) {
+        return STANDARD_ERROR;
     }
-    if (f->largeBoatLives > 0) {
-        boatStates |= FIELD_BOAT_STATUS_LARGE;
+    uint32_t r = RandomBelow(rng, fieldFleetTotal);
+    int h, l, m, s;
+
+    for (h = 0; r >= fieldFleetCountHuge[h]; h++) {
+        r -= fieldFleetCountHuge[h];
     }
-    if (f->hugeBoatLives > 0) {
-        boatStates |= FIELD_BOAT_STATUS_HUGE;
+    for (l = 0; r >= fieldFleetCountHugeLarge[h][l]; l++) {
+        r -= fieldFleetCountHugeLarge[h][l];
     }
-    return boatStates;
-}
+    const FieldPlacement *huge = &fieldPlacements[fieldPlacementStart[FIELD_BOAT_TYPE_HUGE] + h];
+    const FieldPlacement *large = &fieldPlacements[fieldPlacementStart[FIELD_BOAT_TYPE_LARGE] + l];
+    FieldMask taken = FieldMaskOr(huge->mask, large->mask);
 
-uint8_t FieldAIPlaceAllBoats(Field *own_field) {
-    uint8_t row;
-    uint8_t col;
-    uint8_t direction;
-    int placedCount = 0;
-    int smallPlaced = FALSE;
-    int mediumPlaced = FALSE;
-    int largePlaced = FALSE;
-    int hugePlaced = FALSE;
-    while (placedCount < 4) {
-        direction = rand() % 2;
-        row = rand() % FIELD_ROWS;
-        col = rand() % FIELD_COLS;
-        if (hugePlaced == FALSE) {
-            
-            if (FieldAddBoat(own_field, row, col, direction, FIELD_BOAT_TYPE_HUGE) == SUCCESS) {
-                hugePlaced = TRUE;
-                placedCount++;
-            }        
-        }
-        else if (largePlaced == FALSE && hugePlaced == TRUE) {
-            
-            if (FieldAddBoat(own_field, row, col, direction, FIELD_BOAT_TYPE_LARGE) == SUCCESS) {
-                largePlaced = TRUE;
-                placedCount++;
-            }        
-        }
-        else if (mediumPlaced == FALSE && largePlaced == TRUE && hugePlaced == TRUE) {
-            
-            if (FieldAddBoat(own_field, row, col, direction, FIELD_BOAT_TYPE_MEDIUM) == SUCCESS) {
-                mediumPlaced = TRUE;
-                placedCount++;
-            }        
+    const FieldPlacement *medium = NULL;
+    for (m = fieldPlacementStart[FIELD_BOAT_TYPE_MEDIUM]; m < fieldPlacementStart[FIELD_BOAT_TYPE_MEDIUM + 1]; m++) {
+        if (FieldMaskIntersects(&fieldPlacements[m].mask, &taken)) {
+            continue;
         }
-        else if (smallPlaced == FALSE && mediumPlaced == TRUE && largePlaced == TRUE && hugePlaced == TRUE) {
-            
-            if (FieldAddBoat(own_field, row, col, direction, FIELD_BOAT_TYPE_SMALL) == SUCCESS) {
-                smallPlaced = TRUE;
-                placedCount++;
-            }        
+        FieldMask withMedium = FieldMaskOr(taken, fieldPlacements[m].mask);
+        uint32_t fits = FieldCountSmallFits(&withMedium);
+        if (r < fits) {
+            medium = &fieldPlacements[m];
+            taken = withMedium;
+            break;
         }
-        
+        r -= fits;
     }
-    if (placedCount == 4) {
-        return SUCCESS;
+
+    const FieldPlacement *small = NULL;
+    for (s = fieldPlacementStart[FIELD_BOAT_TYPE_SMALL]; medium && s < fieldPlacementStart[FIELD_BOAT_TYPE_SMALL + 1]; s++) {
+        if (!FieldMaskIntersects(&fieldPlacements[s].mask, &taken) && r-- == 0) {
+            small = &fieldPlacements[s];
+            break;
+        }
     }
-    else {
+    if (!small) {
+        // Only reachable if the tables were generated for a different field.
         return STANDARD_ERROR;
     }
-        
+
+    FieldAddBoat(own_field, huge->row, huge->col, huge->dir, FIELD_BOAT_TYPE_HUGE);
+    FieldAddBoat(own_field, large->row, large->col, large->dir, FIELD_BOAT_TYPE_LARGE);
+    FieldAddBoat(own_field, medium->row, medium->col, medium->dir, FIELD_BOAT_TYPE_MEDIUM);
+    FieldAddBoat(own_field, small->row, small->col, small->dir, FIELD_BOAT_TYPE_SMALL);
+    return SUCCESS;
 }
 /**
  * Given a field, decide the next guess.
@@ -430,19 +469,89 @@ uint8_t FieldAIPlaceAllBoats(Field *own_field) {
  *           result parameter is irrelevant.
  */
 GuessData FieldAIDecideGuess(const Field *opp_field) {
-    int row = 0;
-    int col = 0;
-    int guessFound = FALSE;
-    while(guessFound == FALSE) {
-        row = rand() % FIELD_ROWS;
-        col = rand() % FIELD_COLS;
-        if (opp_field->grid[row][col] == FIELD_SQUARE_UNKNOWN) {
-            GuessData own_guess;
-            own_guess->col = col;
-            own_guess->row = row;
-            guessFound = TRUE;
-            return own_guess;
+    return FieldAIDecideGuessWith(opp_field, &randomDefault);
+}
+
+GuessData FieldAIDecideGuessWith(const Field *opp_field, RandomState *rng) {
+    uint32_t density[FIELD_NUM_SQUARES];
+    FieldAIComputeDensity(opp_field, density);
+    return FieldAIPickDensest(opp_field, density, rng);
+}
+
+FieldMask FieldAIBlockedSquares(const Field *opp_field)
+{
+    return FieldMaskOr(FieldKnownEmpty(opp_field), FieldResolvedBoats(opp_field));
+}
+
+uint32_t FieldAIPlacementWeight(const FieldMask *placement, const FieldMask *blocked,
+        const FieldMask *hit)
+{
+    if (FieldMaskIntersects(placement, blocked)) {
+        return 0;
+    }
+    // A boat that is still alive cannot lie entirely on hit squares.
+    FieldMask unhit = FieldMaskAndNot(*placement, *hit);
+    if (FieldMaskIsEmpty(&unhit)) {
+        return 0;
+    }
+    FieldMask hits = FieldMaskAnd(*placement, *hit);
+    return 1UL << (FIELD_AI_HIT_SHIFT * FieldMaskCount(&hits));
+}
+
+void FieldAIComputeDensity(const Field *opp_field, uint32_t density[FIELD_NUM_SQUARES])
+{
+    FieldMask blocked = FieldAIBlockedSquares(opp_field);
+    uint8_t alive = FieldGetBoatStates(opp_field);
+    int type, p;
+
+    for (p = 0; p < FIELD_NUM_SQUARES; p++) {
+        density[p] = 0;
+    }
+    for (type = FIELD_BOAT_TYPE_SMALL; type <= FIELD_BOAT_TYPE_HUGE; type++) {
+        if (!(alive & (1 << type))) {
+            continue;
+        }
+        for (p = fieldPlacementStart[type]; p < fieldPlacementStart[type + 1]; p++) {
+            const FieldMask *mask = &fieldPlacements[p].mask;
+            uint32_t weight = FieldAIPlacementWeight(mask, &blocked, &opp_field->hit);
+            if (weight == 0) {
+                continue;
+            }
+            FieldMask unknown = FieldMaskAnd(*mask, opp_field->unknown);
+            while (!FieldMaskIsEmpty(&unknown)) {
+                density[FieldMaskPopLowest(&unknown)] += weight;
+            }
         }
     }
-   
+}
+
+GuessData FieldAIPickDensest(const Field *opp_field, const uint32_t density[FIELD_NUM_SQUARES],
+        RandomState *rng)
+{
+    GuessData own_guess = {0, 0, RESULT_MISS};
+    FieldMask unknown = opp_field->unknown;
+    uint32_t best = 0;
+    uint32_t ties = 0;
+    uint16_t bestSquare = 0;
+
+    if (FieldMaskIsEmpty(&unknown)) {
+        return own_guess;
+    }
+    bestSquare = FieldMaskPopLowest(&unknown);
+    best = density[bestSquare];
+    ties = 1;
+    while (!FieldMaskIsEmpty(&unknown)) {
+        uint16_t square = FieldMaskPopLowest(&unknown);
+        if (density[square] > best) {
+            best = density[square];
+            bestSquare = square;
+            ties = 1;
+        } else if (density[square] == best && RandomBelow(rng, ++ties) == 0) {
+            // Reservoir sampling keeps every tied square equally likely.
+            bestSquare = square;
+        }
+    }
+    own_guess.row = bestSquare / FIELD_COLS;
+    own_guess.col = bestSquare % FIELD_COLS;
+    return own_guess;
 }
@@ -2,6 +2,7 @@
 #define FIELD_H
 
 #include <stdint.h>
+#include "Random.h"
 
 /**
  * Define the dimensions of the game field. They can be overridden by compile-time specifications.
@@ -67,17 +68,6 @@ typedef struct {
     ShotResult result; // result of a shot at this coordinate
 } GuessData;
 
-/**
- * A struct for tracking all of the necessary data for an agent's field.
- */
-typedef struct {
-    uint8_t grid[FIELD_ROWS][FIELD_COLS];
-    uint8_t smallBoatLives;
-    uint8_t mediumBoatLives;
-    uint8_t largeBoatLives;
-    uint8_t hugeBoatLives;
-} Field;
-
 /**
  * Specify how many boats there exist on the field. There is 1 boat of each of the 4 types, so 4
  * total.
@@ -130,6 +120,154 @@ typedef enum {
     FIELD_BOAT_SIZE_HUGE = 6
 } BoatSize;
 
+/**
+ * The field is stored as a set of bitboards with one bit per square. Squares are numbered
+ * row-major, so (row, col) is bit `row * FIELD_COLS + col`. The default 6x10 field fits in a
+ * single 64-bit word; larger fields spill into additional words, which the helpers below loop
+ * over (the loops disappear when FIELD_MASK_WORDS is 1).
+ */
+#define FIELD_NUM_SQUARES (FIELD_ROWS * FIELD_COLS)
+#define FIELD_MASK_WORDS ((FIELD_NUM_SQUARES + 63) / 64)
+
+typedef struct {
+    uint64_t word[FIELD_MASK_WORDS];
+} FieldMask;
+
+/**
+ * A struct for tracking all of the necessary data for an agent's field.
+ *
+ * A square that is in none of the masks is FIELD_SQUARE_EMPTY. On the opponent's field a miss
+ * simply clears the `unknown` bit, so it reads back as FIELD_SQUARE_EMPTY, while `miss` is only
+ * used on an agent's own field. On the opponent's field `boats` holds the squares of any boat
+ * whose position has been pinned down after it was sunk.
+ *
+ * Use FieldGetSquareStatus() / FieldSetSquareStatus() for a per-square view of the field.
+ */
+typedef struct {
+    FieldMask unknown;
+    FieldMask hit;
+    FieldMask miss;
+    FieldMask cursor;
+    FieldMask boats[FIELD_NUM_BOATS]; // Indexed by BoatType.
+    uint8_t aliveBoats; // BoatStatusFlag bits of the boats that are still afloat.
+} Field;
+
+/**
+ * Helpers for working with FieldMasks.
+ */
+static inline uint16_t FieldSquareIndex(uint8_t row, uint8_t col)
+{
+    return row * FIELD_COLS + col;
+}
+
+static inline void FieldMaskClear(FieldMask *m)
+{
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        m->word[i] = 0;
+    }
+}
+
+/**
+ * Returns a mask with every valid square of the field set.
+ */
+static inline FieldMask FieldMaskAll(void)
+{
+    FieldMask m;
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        m.word[i] = ~0ULL;
+    }
+    if (FIELD_NUM_SQUARES % 64) {
+        m.word[FIELD_MASK_WORDS - 1] = (1ULL << (FIELD_NUM_SQUARES % 64)) - 1;
+    }
+    return m;
+}
+
+static inline void FieldMaskSet(FieldMask *m, uint16_t square)
+{
+    m->word[square >> 6] |= 1ULL << (square & 63);
+}
+
+static inline void FieldMaskReset(FieldMask *m, uint16_t square)
+{
+    m->word[square >> 6] &= ~(1ULL << (square & 63));
+}
+
+static inline int FieldMaskTest(const FieldMask *m, uint16_t square)
+{
+    return (m->word[square >> 6] >> (square & 63)) & 1;
+}
+
+static inline FieldMask FieldMaskOr(FieldMask a, FieldMask b)
+{
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        a.word[i] |= b.word[i];
+    }
+    return a;
+}
+
+static inline FieldMask FieldMaskAnd(FieldMask a, FieldMask b)
+{
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        a.word[i] &= b.word[i];
+    }
+    return a;
+}
+
+static inline FieldMask FieldMaskAndNot(FieldMask a, FieldMask b)
+{
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        a.word[i] &= ~b.word[i];
+    }
+    return a;
+}
+
+static inline int FieldMaskIsEmpty(const FieldMask *m)
+{
+    uint64_t any = 0;
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        any |= m->word[i];
+    }
+    return any == 0;
+}
+
+static inline int FieldMaskIntersects(const FieldMask *a, const FieldMask *b)
+{
+    uint64_t any = 0;
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        any |= a->word[i] & b->word[i];
+    }
+    return any != 0;
+}
+
+static inline int FieldMaskCount(const FieldMask *m)
+{
+    int count = 0;
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        count += __builtin_popcountll(m->word[i]);
+    }
+    return count;
+}
+
+/**
+ * Removes the lowest set square from `m` and returns its index. `m` must not be empty.
+ */
+static inline uint16_t FieldMaskPopLowest(FieldMask *m)
+{
+    int i;
+    for (i = 0; i < FIELD_MASK_WORDS - 1 && m->word[i] == 0; i++);
+    uint16_t square = i * 64 + __builtin_ctzll(m->word[i]);
+    m->word[i] &= m->word[i] - 1;
+    return square;
+}
+
 /**
  * This function is optional, but recommended.   It prints a representation of both
  * fields, similar to the OLED display.
@@ -144,8 +282,8 @@ void FieldPrint_UART(Field *own_field, Field * opp_field);
  * FieldInit() will initialize two passed field structs for the beginning of play.
  * Each field's grid should be filled with the appropriate SquareStatus (
  * FIELD_SQUARE_EMPTY for your own field, FIELD_SQUARE_UNKNOWN for opponent's).
- * Additionally, your opponent's field's boatLives parameters should be filled
- *  (your own field's boatLives will be filled when boats are added)
+ * Additionally, your opponent's field's aliveBoats flags should be filled
+ *  (your own field's aliveBoats will be filled when boats are added)
  * 
  * FieldAI_PlaceAllBoats() should NOT be called in this function.
  * 
@@ -188,7 +326,7 @@ SquareStatus FieldSetSquareStatus(Field *f, uint8_t row, uint8_t col, SquareStat
  * field is unmodified and STANDARD_ERROR is returned. There is no hard-coded limit to how many
  * times a boat can be added to a field within this function.
  * 
- * In addition, this function should update the appropriate boatLives parameter of the field.
+ * In addition, this function should update the aliveBoats flags of the field.
  *
  * So this is valid test code:
  * {
@@ -239,7 +377,7 @@ SquareStatus FieldRegisterEnemyAttack(Field *own_field, GuessData *opp_guess);
  * FIELD_SQUARE_HIT at that position. If it was a miss, display a FIELD_SQUARE_EMPTY instead, as
  * it is now known that there was no boat there. The FieldState struct also contains data on how
  * many lives each ship has. Each hit only reports if it was a hit on any boat or if a specific boat
- * was sunk, this function also clears a boats lives if it detects that the hit was a
+ * was sunk, this function also clears a boat's alive flag if it detects that the hit was a
  * RESULT_*_BOAT_SUNK.
  * @param f The field to grab data from.
  * @param gData The coordinates that were guessed along with their HitStatus.
@@ -269,6 +407,11 @@ uint8_t FieldGetBoatStates(const Field *f);
  */
 uint8_t FieldAIPlaceAllBoats(Field *own_field);
 
+/**
+ * FieldAIPlaceAllBoats(), drawing from `rng` rather than randomDefault.
+ */
+uint8_t FieldAIPlaceAllBoatsWith(Field *own_field, RandomState *rng);
+
 /**
  * Given a field, decide the next guess.
  *
@@ -283,6 +426,45 @@ uint8_t FieldAIPlaceAllBoats(Field *own_field);
  */
 GuessData FieldAIDecideGuess(const Field *opp_field);
 
+/**
+ * FieldAIDecideGuess(), breaking ties with `rng` rather than randomDefault.
+ */
+GuessData FieldAIDecideGuessWith(const Field *opp_field, RandomState *rng);
+
+/**
+ * FieldAIDecideGuess() hunts by placement density: every placement of a boat that is still
+ * alive and fits the known misses, sunk boats and hits adds its weight to each unknown square it
+ * covers, and the densest square is shot. A placement's weight is
+ * 1 << (FIELD_AI_HIT_SHIFT * number of unresolved hits it covers), which steers the AI onto boats
+ * it has already found. Everything is integer math on the stack.
+ */
+#define FIELD_AI_HIT_SHIFT 3
+
+/**
+ * Fills `density` (indexed by FieldSquareIndex()) with the placement density described above.
+ * Squares that are not unknown are left at 0.
+ */
+void FieldAIComputeDensity(const Field *opp_field, uint32_t density[FIELD_NUM_SQUARES]);
+
+/**
+ * Returns the squares no live boat can cover: known misses and the boats pinned down after
+ * being sunk.
+ */
+FieldMask FieldAIBlockedSquares(const Field *opp_field);
+
+/**
+ * Returns the weight FieldAIComputeDensity() gives a placement of a boat that is still alive,
+ * or 0 if the placement touches `blocked` (from FieldAIBlockedSquares()) or lies entirely on `hit`.
+ */
+uint32_t FieldAIPlacementWeight(const FieldMask *placement, const FieldMask *blocked,
+        const FieldMask *hit);
+
+/**
+ * Picks the unknown square with the highest density, breaking ties at random with `rng`.
+ */
+GuessData FieldAIPickDensest(const Field *opp_field, const uint32_t density[FIELD_NUM_SQUARES],
+        RandomState *rng);
+
 /** 
  * For Extra Credit:  Make the two "AI" functions above 
  * smart enough to beat our AI in more than 55% of games.
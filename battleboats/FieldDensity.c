@@ -0,0 +1,88 @@
+/*
+ * File:   FieldDensity.c
+ *
+ * Incremental placement density for the opponent's field. See FieldDensity.h.
+ */
+
+#include "FieldDensity.h"
+#include "BOARD.h"
+
+/**
+ * Recomputes the weight of placement `p` and applies the change to the unknown squares it covers.
+ */
+static void FieldDensityReweigh(FieldDensity *d, const Field *opp_field, const FieldMask *blocked,
+        uint16_t p)
+{
+    const FieldMask *mask = &fieldPlacements[p].mask;
+    uint32_t weight = 0;
+    if (opp_field->aliveBoats & (1 << FieldPlacementType(p))) {
+        weight = FieldAIPlacementWeight(mask, blocked, &opp_field->hit);
+    }
+    if (weight == d->weight[p]) {
+        return;
+    }
+    FieldMask unknown = FieldMaskAnd(*mask, opp_field->unknown);
+    while (!FieldMaskIsEmpty(&unknown)) {
+        uint16_t square = FieldMaskPopLowest(&unknown);
+        d->density[square] = d->density[square] - d->weight[p] + weight;
+    }
+    d->weight[p] = weight;
+}
+
+/**
+ * Reweighs every placement that covers `square`.
+ */
+static void FieldDensityReweighSquare(FieldDensity *d, const Field *opp_field,
+        const FieldMask *blocked, uint16_t square)
+{
+    uint16_t i;
+    for (i = fieldSquarePlacementStart[square]; i < fieldSquarePlacementStart[square + 1]; i++) {
+        FieldDensityReweigh(d, opp_field, blocked, fieldSquarePlacements[i]);
+    }
+}
+
+void FieldDensityInit(FieldDensity *d, const Field *opp_field)
+{
+    FieldMask blocked = FieldAIBlockedSquares(opp_field);
+    uint16_t i;
+    for (i = 0; i < FIELD_NUM_SQUARES; i++) {
+        d->density[i] = 0;
+    }
+    for (i = 0; i < FIELD_NUM_PLACEMENTS; i++) {
+        d->weight[i] = 0;
+        FieldDensityReweigh(d, opp_field, &blocked, i);
+    }
+}
+
+void FieldDensityUpdate(FieldDensity *d, const Field *opp_field, const GuessData *guess)
+{
+    if (guess->row >= FIELD_ROWS || guess->col >= FIELD_COLS) {
+        return;
+    }
+    FieldMask blocked = FieldAIBlockedSquares(opp_field);
+    uint16_t square = FieldSquareIndex(guess->row, guess->col);
+
+    // The shot square is no longer unknown, so it drops out of the map. Only the placements
+    // covering it can have changed weight.
+    d->density[square] = 0;
+    FieldDensityReweighSquare(d, opp_field, &blocked, square);
+
+    if (guess->result >= RESULT_SMALL_BOAT_SUNK && guess->result <= RESULT_HUGE_BOAT_SUNK) {
+        BoatType type = guess->result - RESULT_SMALL_BOAT_SUNK;
+        uint16_t p;
+        // The sunk boat can no longer be anywhere...
+        for (p = fieldPlacementStart[type]; p < fieldPlacementStart[type + 1]; p++) {
+            FieldDensityReweigh(d, opp_field, &blocked, p);
+        }
+        // ...and nothing else can overlap it, if FieldUpdateKnowledge() could pin it down.
+        FieldMask pinned = opp_field->boats[type];
+        while (!FieldMaskIsEmpty(&pinned)) {
+            FieldDensityReweighSquare(d, opp_field, &blocked, FieldMaskPopLowest(&pinned));
+        }
+    }
+}
+
+GuessData FieldDensityDecideGuess(const FieldDensity *d, const Field *opp_field, RandomState *rng)
+{
+    return FieldAIPickDensest(opp_field, d->density, rng);
+}
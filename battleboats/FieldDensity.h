@@ -0,0 +1,49 @@
+#ifndef FIELD_DENSITY_H
+#define FIELD_DENSITY_H
+
+#include <stdint.h>
+#include "Field.h"
+#include "FieldPlacement.h"
+
+/**
+ * An incrementally maintained copy of the placement density that FieldAIComputeDensity()
+ * computes from scratch. It is kept alongside the opponent's Field and updated after every
+ * FieldUpdateKnowledge() call, so a shot only revisits the placements that cover the shot square
+ * (plus, on a sinking, the placements of the sunk boat and those crossing its pinned squares)
+ * instead of every placement on the field.
+ *
+ * At all times density[s] is the sum of weight[p] over the placements p covering the unknown
+ * square s, and is 0 for squares that are not unknown.
+ */
+typedef struct {
+    uint32_t density[FIELD_NUM_SQUARES];
+    uint32_t weight[FIELD_NUM_PLACEMENTS];
+} FieldDensity;
+
+/**
+ * Computes the density of opp_field from scratch. Call this after FieldInit().
+ *
+ * @param d         The density map to initialize.
+ * @param opp_field The opponent's field it tracks.
+ */
+void FieldDensityInit(FieldDensity *d, const Field *opp_field);
+
+/**
+ * Brings the density map up to date with a shot whose result has already been applied to
+ * opp_field with FieldUpdateKnowledge().
+ *
+ * @param d         The density map, last updated for the opp_field state before this shot.
+ * @param opp_field The opponent's field after FieldUpdateKnowledge().
+ * @param guess     The shot that was passed to FieldUpdateKnowledge().
+ */
+void FieldDensityUpdate(FieldDensity *d, const Field *opp_field, const GuessData *guess);
+
+/**
+ * Decides the next guess from the density map, exactly as FieldAIDecideGuessWith() would with the
+ * same `rng`.
+ *
+ * @return a GuessData struct whose row and col parameters are the coordinates of the guess.
+ */
+GuessData FieldDensityDecideGuess(const FieldDensity *d, const Field *opp_field, RandomState *rng);
+
+#endif // FIELD_DENSITY_H
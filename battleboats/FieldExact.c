@@ -0,0 +1,318 @@
+/*
+ * File:   FieldExact.c
+ *
+ * Exact posterior targeting by enumerating every consistent fleet. See FieldExact.h.
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "FieldExact.h"
+#include "BOARD.h"
+
+/**
+ * The state shared by the workers of one FieldExactCompute() call.
+ */
+typedef struct {
+    FieldExact *x;
+    const Field *opp_field;
+    uint8_t fits[FIELD_NUM_PLACEMENTS]; // Whether each placement passes its own boat's tests.
+    uint16_t candidates[FIELD_NUM_BOATS][FIELD_NUM_PLACEMENTS];
+    uint16_t candidateCount[FIELD_NUM_BOATS];
+    atomic_int nextPartition;
+    atomic_int failed;
+} FieldExactJob;
+
+typedef struct {
+    FieldExactJob *job;
+    pthread_t thread;
+    uint64_t fleets;
+    uint64_t placementCount[FIELD_NUM_PLACEMENTS];
+} FieldExactWorker;
+
+/**
+ * The tests a placement of `type` must pass on its own, before it is combined with other boats.
+ */
+static uint8_t FieldExactPlacementFits(const FieldExact *x, const Field *opp_field,
+        BoatType type, const FieldMask *mask)
+{
+    FieldMask missed = FieldMaskAndNot(FieldMaskAndNot(FieldMaskAll(), opp_field->unknown),
+            opp_field->hit);
+    FieldMask unhit = FieldMaskAndNot(*mask, opp_field->hit);
+    if (FieldMaskIntersects(mask, &missed)) {
+        return FALSE;
+    }
+    if (x->sunkSquare[type] < 0) {
+        // Still afloat, so at least one of its squares has not been hit.
+        return !FieldMaskIsEmpty(&unhit);
+    }
+    // Sunk, so it lies entirely on hits and the sinking shot was the last of them.
+    if (!FieldMaskIsEmpty(&unhit) || !FieldMaskTest(mask, x->sunkSquare[type])) {
+        return FALSE;
+    }
+    FieldMask squares = *mask;
+    while (!FieldMaskIsEmpty(&squares)) {
+        if (x->hitTime[FieldMaskPopLowest(&squares)] > x->hitTime[x->sunkSquare[type]]) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static int FieldExactAppend(FieldExactPartition *part, uint16_t large, uint16_t medium,
+        uint16_t small)
+{
+    if (part->count == part->capacity) {
+        uint32_t capacity = part->capacity ? part->capacity * 2 : 256;
+        void *fleets = realloc(part->fleets, capacity * sizeof (*part->fleets));
+        if (fleets == NULL) {
+            return STANDARD_ERROR;
+        }
+        part->fleets = fleets;
+        part->capacity = capacity;
+    }
+    part->fleets[part->count][0] = large;
+    part->fleets[part->count][1] = medium;
+    part->fleets[part->count][2] = small;
+    part->count++;
+    return SUCCESS;
+}
+
+/**
+ * Enumerates every consistent fleet whose HUGE boat is at placement `huge`.
+ */
+static int FieldExactEnumerate(FieldExactJob *job, FieldExactPartition *part, uint16_t huge)
+{
+    const FieldMask *hit = &job->opp_field->hit;
+    const FieldMask *hugeMask = &fieldPlacements[huge].mask;
+    int l, m, s;
+
+    for (l = 0; l < job->candidateCount[FIELD_BOAT_TYPE_LARGE]; l++) {
+        uint16_t large = job->candidates[FIELD_BOAT_TYPE_LARGE][l];
+        if (FieldMaskIntersects(&fieldPlacements[large].mask, hugeMask)) {
+            continue;
+        }
+        FieldMask withLarge = FieldMaskOr(*hugeMask, fieldPlacements[large].mask);
+        FieldMask uncovered = FieldMaskAndNot(*hit, withLarge);
+        if (FieldMaskCount(&uncovered) > FIELD_BOAT_SIZE_MEDIUM + FIELD_BOAT_SIZE_SMALL) {
+            continue;
+        }
+        for (m = 0; m < job->candidateCount[FIELD_BOAT_TYPE_MEDIUM]; m++) {
+            uint16_t medium = job->candidates[FIELD_BOAT_TYPE_MEDIUM][m];
+            if (FieldMaskIntersects(&fieldPlacements[medium].mask, &withLarge)) {
+                continue;
+            }
+            FieldMask withMedium = FieldMaskOr(withLarge, fieldPlacements[medium].mask);
+            uncovered = FieldMaskAndNot(*hit, withMedium);
+            if (FieldMaskCount(&uncovered) > FIELD_BOAT_SIZE_SMALL) {
+                continue;
+            }
+            for (s = 0; s < job->candidateCount[FIELD_BOAT_TYPE_SMALL]; s++) {
+                uint16_t small = job->candidates[FIELD_BOAT_TYPE_SMALL][s];
+                const FieldMask *smallMask = &fieldPlacements[small].mask;
+                FieldMask left = FieldMaskAndNot(uncovered, *smallMask);
+                if (FieldMaskIntersects(smallMask, &withMedium) || !FieldMaskIsEmpty(&left)) {
+                    continue;
+                }
+                if (FieldExactAppend(part, large, medium, small) != SUCCESS) {
+                    return STANDARD_ERROR;
+                }
+            }
+        }
+    }
+    part->enumerated = TRUE;
+    return SUCCESS;
+}
+
+/**
+ * Drops the fleets of an already enumerated partition that new knowledge rules out. The boats of
+ * a cached fleet are known not to overlap, so only the per-boat tests and hit coverage remain.
+ */
+static void FieldExactFilter(FieldExactJob *job, FieldExactPartition *part, uint16_t huge)
+{
+    const FieldMask *hit = &job->opp_field->hit;
+    uint32_t i, kept = 0;
+    for (i = 0; i < part->count; i++) {
+        const uint16_t *fleet = part->fleets[i];
+        if (!job->fits[fleet[0]] || !job->fits[fleet[1]] || !job->fits[fleet[2]]) {
+            continue;
+        }
+        FieldMask covered = FieldMaskOr(FieldMaskOr(fieldPlacements[huge].mask,
+                fieldPlacements[fleet[0]].mask),
+                FieldMaskOr(fieldPlacements[fleet[1]].mask, fieldPlacements[fleet[2]].mask));
+        FieldMask uncovered = FieldMaskAndNot(*hit, covered);
+        if (FieldMaskIsEmpty(&uncovered)) {
+            memmove(part->fleets[kept++], fleet, sizeof (*part->fleets));
+        }
+    }
+    part->count = kept;
+}
+
+static void *FieldExactWork(void *arg)
+{
+    FieldExactWorker *worker = arg;
+    FieldExactJob *job = worker->job;
+    int h;
+
+    while ((h = atomic_fetch_add(&job->nextPartition, 1)) < FIELD_NUM_HUGE_PLACEMENTS) {
+        FieldExactPartition *part = &job->x->partition[h];
+        uint16_t huge = fieldPlacementStart[FIELD_BOAT_TYPE_HUGE] + h;
+        uint32_t i;
+
+        if (!job->fits[huge]) {
+            part->count = 0;
+            part->enumerated = TRUE;
+        } else if (part->enumerated) {
+            FieldExactFilter(job, part, huge);
+        } else if (FieldExactEnumerate(job, part, huge) != SUCCESS) {
+            atomic_store(&job->failed, TRUE);
+            break;
+        }
+
+        worker->fleets += part->count;
+        worker->placementCount[huge] += part->count;
+        for (i = 0; i < part->count; i++) {
+            worker->placementCount[part->fleets[i][0]]++;
+            worker->placementCount[part->fleets[i][1]]++;
+            worker->placementCount[part->fleets[i][2]]++;
+        }
+    }
+    return NULL;
+}
+
+void FieldExactInit(FieldExact *x, int threads)
+{
+    int i;
+    memset(x, 0, sizeof (*x));
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int) cpus : 1;
+    }
+    x->threads = threads;
+    for (i = 0; i < FIELD_NUM_BOATS; i++) {
+        x->sunkSquare[i] = -1;
+    }
+}
+
+void FieldExactFree(FieldExact *x)
+{
+    int h;
+    for (h = 0; h < FIELD_NUM_HUGE_PLACEMENTS; h++) {
+        free(x->partition[h].fleets);
+        x->partition[h].fleets = NULL;
+        x->partition[h].count = x->partition[h].capacity = 0;
+        x->partition[h].enumerated = FALSE;
+    }
+}
+
+void FieldExactUpdate(FieldExact *x, const GuessData *guess)
+{
+    if (guess->row >= FIELD_ROWS || guess->col >= FIELD_COLS || guess->result == RESULT_MISS) {
+        return;
+    }
+    uint16_t square = FieldSquareIndex(guess->row, guess->col);
+    if (x->hitTime[square] == 0) {
+        x->hitTime[square] = ++x->hits;
+    }
+    if (guess->result >= RESULT_SMALL_BOAT_SUNK && guess->result <= RESULT_HUGE_BOAT_SUNK) {
+        x->sunkSquare[guess->result - RESULT_SMALL_BOAT_SUNK] = square;
+    }
+}
+
+int FieldExactCompute(FieldExact *x, const Field *opp_field)
+{
+    FieldExactJob job;
+    FieldExactWorker *workers;
+    int type, i, started;
+    uint16_t p;
+
+    workers = calloc(x->threads, sizeof (*workers));
+    if (workers == NULL) {
+        return STANDARD_ERROR;
+    }
+    job.x = x;
+    job.opp_field = opp_field;
+    for (type = FIELD_BOAT_TYPE_SMALL; type <= FIELD_BOAT_TYPE_HUGE; type++) {
+        job.candidateCount[type] = 0;
+        for (p = fieldPlacementStart[type]; p < fieldPlacementStart[type + 1]; p++) {
+            job.fits[p] = FieldExactPlacementFits(x, opp_field, type, &fieldPlacements[p].mask);
+            if (job.fits[p]) {
+                job.candidates[type][job.candidateCount[type]++] = p;
+            }
+        }
+    }
+    atomic_init(&job.nextPartition, 0);
+    atomic_init(&job.failed, FALSE);
+
+    // The calling thread is worker 0.
+    for (started = 1; started < x->threads; started++) {
+        workers[started].job = &job;
+        if (pthread_create(&workers[started].thread, NULL, FieldExactWork, &workers[started]) != 0) {
+            break;
+        }
+    }
+    workers[0].job = &job;
+    FieldExactWork(&workers[0]);
+    for (i = 1; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    x->fleets = 0;
+    memset(x->placementCount, 0, sizeof (x->placementCount));
+    for (i = 0; i < started; i++) {
+        x->fleets += workers[i].fleets;
+        for (p = 0; p < FIELD_NUM_PLACEMENTS; p++) {
+            x->placementCount[p] += workers[i].placementCount[p];
+        }
+    }
+    free(workers);
+    for (i = 0; i < FIELD_NUM_SQUARES; i++) {
+        x->squareCount[i] = 0;
+        for (p = fieldSquarePlacementStart[i]; p < fieldSquarePlacementStart[i + 1]; p++) {
+            x->squareCount[i] += x->placementCount[fieldSquarePlacements[p]];
+        }
+    }
+
+    if (atomic_load(&job.failed)) {
+        // A partition may be half enumerated, so start over next time.
+        FieldExactFree(x);
+        return STANDARD_ERROR;
+    }
+    return x->fleets ? SUCCESS : STANDARD_ERROR;
+}
+
+double FieldExactProbability(const FieldExact *x, uint8_t row, uint8_t col)
+{
+    if (x->fleets == 0 || row >= FIELD_ROWS || col >= FIELD_COLS) {
+        return 0.0;
+    }
+    return (double) x->squareCount[FieldSquareIndex(row, col)] / x->fleets;
+}
+
+GuessData FieldExactDecideGuess(FieldExact *x, const Field *opp_field, RandomState *rng)
+{
+    GuessData own_guess = {0, 0, RESULT_MISS};
+    FieldMask unknown = opp_field->unknown;
+    uint64_t best = 0;
+    uint32_t ties = 0;
+    uint16_t bestSquare = 0;
+
+    if (FieldExactCompute(x, opp_field) != SUCCESS) {
+        return FieldAIDecideGuessWith(opp_field, rng);
+    }
+    while (!FieldMaskIsEmpty(&unknown)) {
+        uint16_t square = FieldMaskPopLowest(&unknown);
+        if (ties == 0 || x->squareCount[square] > best) {
+            best = x->squareCount[square];
+            bestSquare = square;
+            ties = 1;
+        } else if (x->squareCount[square] == best && RandomBelow(rng, ++ties) == 0) {
+            bestSquare = square;
+        }
+    }
+    own_guess.row = bestSquare / FIELD_COLS;
+    own_guess.col = bestSquare % FIELD_COLS;
+    return own_guess;
+}
@@ -0,0 +1,95 @@
+#ifndef FIELD_EXACT_H
+#define FIELD_EXACT_H
+
+#include <stdint.h>
+#include "Field.h"
+#include "FieldPlacement.h"
+
+/**
+ * FieldExact is a host-only reference targeter. It enumerates every fleet (one non-overlapping
+ * placement of each boat) that is consistent with everything learned about the opponent's field,
+ * and shoots the unknown square covered by the most of them, i.e. the square with the highest
+ * exact posterior probability of holding a boat when all consistent fleets are equally likely.
+ *
+ * A fleet is consistent when:
+ *   - no boat covers a known miss,
+ *   - the boats together cover every hit,
+ *   - a boat reported sunk lies entirely on hits and was sunk by the last of them, and
+ *   - a boat that is still alive does not lie entirely on hits.
+ *
+ * The enumeration is split into one partition per HUGE boat placement, and the partitions are
+ * spread over worker threads. Each partition keeps the fleets that survived the previous call.
+ * Knowledge only ever grows, so later calls just filter those survivors instead of enumerating
+ * again, and a partition that empties stays empty.
+ *
+ * This needs pthreads and a few tens of megabytes for the first enumeration, so it is not part of
+ * the PIC32 build.
+ */
+
+/**
+ * The fleets surviving in one HUGE-placement partition, stored as placement indices into
+ * fieldPlacements for the LARGE, MEDIUM and SMALL boats.
+ */
+typedef struct {
+    uint16_t (*fleets)[3];
+    uint32_t count;
+    uint32_t capacity;
+    uint8_t enumerated;
+} FieldExactPartition;
+
+typedef struct {
+    int threads; // Worker threads used by FieldExactCompute().
+
+    // Shot history recorded by FieldExactUpdate().
+    uint16_t hits;
+    uint16_t hitTime[FIELD_NUM_SQUARES];   // The order in which each square was hit, or 0.
+    int16_t sunkSquare[FIELD_NUM_BOATS];   // Square whose shot sank each boat, or -1.
+
+    // Results of the last FieldExactCompute().
+    uint64_t fleets;                                 // Number of consistent fleets.
+    uint64_t placementCount[FIELD_NUM_PLACEMENTS];   // Consistent fleets using each placement.
+    uint64_t squareCount[FIELD_NUM_SQUARES];         // Consistent fleets covering each square.
+
+    FieldExactPartition partition[FIELD_NUM_HUGE_PLACEMENTS];
+} FieldExact;
+
+/**
+ * Prepares a FieldExact for a new game. Call it alongside FieldInit().
+ *
+ * @param x       The targeter to initialize.
+ * @param threads Worker threads to use, or 0 to use one per online CPU.
+ */
+void FieldExactInit(FieldExact *x, int threads);
+
+/**
+ * Releases the fleets cached by a FieldExact. It can be initialized again afterwards.
+ */
+void FieldExactFree(FieldExact *x);
+
+/**
+ * Records a shot whose result has been applied to the opponent's field with
+ * FieldUpdateKnowledge(). Every shot must be recorded, in order.
+ */
+void FieldExactUpdate(FieldExact *x, const GuessData *guess);
+
+/**
+ * Counts the fleets consistent with opp_field and the recorded shots, filling x->fleets,
+ * x->placementCount and x->squareCount.
+ *
+ * @return SUCCESS, or STANDARD_ERROR if no fleet is consistent (the opponent misreported a shot)
+ *         or memory ran out.
+ */
+int FieldExactCompute(FieldExact *x, const Field *opp_field);
+
+/**
+ * Returns the probability, as of the last FieldExactCompute(), that a boat covers (row, col).
+ */
+double FieldExactProbability(const FieldExact *x, uint8_t row, uint8_t col);
+
+/**
+ * Runs FieldExactCompute() and returns the unknown square most likely to hold a boat, breaking
+ * ties at random with `rng`. Falls back to FieldAIDecideGuessWith() if the computation fails.
+ */
+GuessData FieldExactDecideGuess(FieldExact *x, const Field *opp_field, RandomState *rng);
+
+#endif // FIELD_EXACT_H
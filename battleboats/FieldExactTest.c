@@ -0,0 +1,193 @@
+/*
+ * File:   FieldExactTest.c
+ *
+ * Host-only test for FieldExact.c, which also compares the exact targeter against
+ * FieldAIDecideGuess() on the same fleets. Link with -pthread.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BOARD.h"
+#include "Field.h"
+#include "FieldExact.h"
+#include "FieldMonteCarlo.h"
+
+static Field testOwnField;
+static Field testOppField;
+static FieldExact testExact;
+static FieldExact testFresh;
+static uint32_t testOccupied[FIELD_NUM_SQUARES];
+
+/**
+ * Whether every boat of `own_field` is in a fleet that `x` counted as consistent.
+ */
+static int FleetCounted(const FieldExact *x, const Field *own_field)
+{
+    int type, p;
+    for (type = FIELD_BOAT_TYPE_SMALL; type <= FIELD_BOAT_TYPE_HUGE; type++) {
+        for (p = fieldPlacementStart[type]; p < fieldPlacementStart[type + 1]; p++) {
+            if (memcmp(&fieldPlacements[p].mask, &own_field->boats[type], sizeof (FieldMask)) == 0) {
+                break;
+            }
+        }
+        if (p == fieldPlacementStart[type + 1] || x->placementCount[p] == 0) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/*
+ *
+ */
+int main(void)
+{
+    int resCount = 0;
+    int trial;
+    printf("Welcome to the FieldExact.c Test!\n");
+
+    printf("Now Testing FieldExactCompute()\n");
+    FieldInit(&testOwnField, &testOppField);
+    FieldExactInit(&testExact, 0);
+    if (FieldExactCompute(&testExact, &testOppField) == SUCCESS &&
+            testExact.fleets == fieldFleetTotal) {
+        resCount++;
+    }
+    FieldExactFree(&testExact);
+    // Cached, multithreaded results must match a fresh single-threaded enumeration every turn,
+    // and the opponent's real fleet must always be among the consistent ones.
+    for (trial = 0; trial < 4; trial++) {
+        int matches = TRUE;
+        FieldInit(&testOwnField, &testOppField);
+        FieldAIPlaceAllBoats(&testOwnField);
+        FieldExactInit(&testExact, 0);
+        FieldExactInit(&testFresh, 1);
+        while (FieldGetBoatStates(&testOwnField)) {
+            GuessData gData = FieldExactDecideGuess(&testExact, &testOppField, &randomDefault);
+            FieldRegisterEnemyAttack(&testOwnField, &gData);
+            FieldUpdateKnowledge(&testOppField, &gData);
+            FieldExactUpdate(&testExact, &gData);
+            FieldExactUpdate(&testFresh, &gData);
+            if (FieldExactCompute(&testExact, &testOppField) != SUCCESS ||
+                    FieldExactCompute(&testFresh, &testOppField) != SUCCESS ||
+                    testExact.fleets != testFresh.fleets ||
+                    memcmp(testExact.squareCount, testFresh.squareCount,
+                    sizeof (testExact.squareCount)) != 0 ||
+                    !FleetCounted(&testExact, &testOwnField)) {
+                matches = FALSE;
+            }
+            FieldExactFree(&testFresh);
+        }
+        if (matches) {
+            resCount++;
+        }
+        FieldExactFree(&testExact);
+    }
+    if (resCount == 5) {
+        printf("PASSED: 5/5 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/5 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing FieldExactDecideGuess()\n");
+    int exactShots = 0;
+    int densityShots = 0;
+    for (trial = 0; trial < 20; trial++) {
+        Field ownCopy, unused;
+        GuessData gData;
+        FieldInit(&testOwnField, &testOppField);
+        FieldAIPlaceAllBoats(&testOwnField);
+        ownCopy = testOwnField;
+
+        FieldExactInit(&testExact, 0);
+        while (FieldGetBoatStates(&testOwnField)) {
+            gData = FieldExactDecideGuess(&testExact, &testOppField, &randomDefault);
+            if (FieldGetSquareStatus(&testOppField, gData.row, gData.col) != FIELD_SQUARE_UNKNOWN) {
+                break;
+            }
+            FieldRegisterEnemyAttack(&testOwnField, &gData);
+            FieldUpdateKnowledge(&testOppField, &gData);
+            FieldExactUpdate(&testExact, &gData);
+            exactShots++;
+        }
+        FieldExactFree(&testExact);
+        if (FieldGetBoatStates(&testOwnField) == 0) {
+            resCount++;
+        }
+
+        // The same fleet against the on-device hunter.
+        testOwnField = ownCopy;
+        FieldInit(&unused, &testOppField);
+        while (FieldGetBoatStates(&testOwnField)) {
+            gData = FieldAIDecideGuess(&testOppField);
+            FieldRegisterEnemyAttack(&testOwnField, &gData);
+            FieldUpdateKnowledge(&testOppField, &gData);
+            densityShots++;
+        }
+    }
+    if (resCount == 20) {
+        printf("PASSED: 20/20 TESTS PASSED (%d.%02d shots per game, FieldAIDecideGuess %d.%02d)\n",
+                exactShots / 20, exactShots * 5 % 100, densityShots / 20, densityShots * 5 % 100);
+    } else {
+        printf("FAILED: %d/20 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing FieldMCCountOccupied()\n");
+    // A board narrowed to its first six columns by misses, with a hit to cover. Few fleets fit,
+    // and redrawing single boats on overlap would be off by almost 0.1 here.
+    GuessData shot;
+    int row, col;
+    FieldInit(&testOwnField, &testOppField);
+    FieldExactInit(&testExact, 0);
+    for (row = 0; row < FIELD_ROWS; row++) {
+        for (col = 0; col < FIELD_COLS; col++) {
+            shot.row = row;
+            shot.col = col;
+            shot.result = RESULT_MISS;
+            if (row == 3 && col == 2) {
+                shot.result = RESULT_HIT;
+            } else if (col < 6) {
+                continue;
+            }
+            FieldUpdateKnowledge(&testOppField, &shot);
+            FieldExactUpdate(&testExact, &shot);
+        }
+    }
+    uint32_t drawn = FieldMCCountOccupied(&testOppField, &randomDefault, 200 * BOARD_CORE_TICKS_PER_MS,
+            testOccupied);
+    if (FieldExactCompute(&testExact, &testOppField) == SUCCESS && drawn >= 20000) {
+        resCount++;
+    }
+    // Every square's share of the samples is within 0.02 of its exact probability, several
+    // standard errors at this many samples.
+    double worst = 0;
+    for (row = 0; row < FIELD_ROWS; row++) {
+        for (col = 0; col < FIELD_COLS; col++) {
+            double error = (double) testOccupied[FieldSquareIndex(row, col)] / (drawn ? drawn : 1)
+                    - (FieldGetSquareStatus(&testOppField, row, col) == FIELD_SQUARE_UNKNOWN ?
+                    FieldExactProbability(&testExact, row, col) : 0);
+            if (error < 0) {
+                error = -error;
+            }
+            if (error > worst) {
+                worst = error;
+            }
+        }
+    }
+    if (worst < 0.02) {
+        resCount++;
+    }
+    FieldExactFree(&testExact);
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED (%lu samples, %llu fleets, largest error %.4f)\n",
+                (unsigned long) drawn, (unsigned long long) testExact.fleets, worst);
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED (%lu samples, largest error %.4f)\n", resCount,
+                (unsigned long) drawn, worst);
+    }
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,240 @@
+/*
+ * File:   FieldMonteCarlo.c
+ *
+ * Monte Carlo guessing under a core timer budget. See FieldMonteCarlo.h.
+ */
+
+#ifndef PIC32
+#define _GNU_SOURCE // For sched_getaffinity() where it exists.
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "FieldMonteCarlo.h"
+#include "FieldPlacement.h"
+#include "BOARD.h"
+
+// Samples drawn between looks at the core timer.
+#define FIELD_MC_BATCH 16
+
+/**
+ * What every sample is drawn from, computed once per call and shared read-only by the workers.
+ */
+typedef struct {
+    uint8_t order[FIELD_NUM_BOATS];   // Boat types to draw, most constrained first.
+    uint8_t boats;                    // Number of entries in order.
+    uint16_t count[FIELD_NUM_BOATS];
+    uint16_t candidates[FIELD_NUM_BOATS][FIELD_NUM_PLACEMENTS];
+    FieldMask mustCover;              // Hits not yet explained by a pinned boat.
+    FieldMask unknown;
+    uint32_t start;
+    uint32_t budget;
+} FieldMCJob;
+
+typedef struct {
+    const FieldMCJob *job;
+    RandomState rng;
+    uint32_t samples;
+    uint32_t occupied[FIELD_NUM_SQUARES];
+#ifndef PIC32
+    pthread_t thread;
+#endif
+} FieldMCWorker;
+
+#ifndef PIC32
+/**
+ * The number of CPUs this process may run on.
+ */
+static int FieldMCUsableCpus(void)
+{
+#ifdef CPU_COUNT
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof (set), &set) == 0 && CPU_COUNT(&set) > 0) {
+        return CPU_COUNT(&set);
+    }
+#endif
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int) cpus : 1;
+}
+#endif
+
+/**
+ * Draws one fleet and, if its boats do not overlap and it explains every hit, counts the unknown
+ * squares it occupies.
+ *
+ * Each boat is drawn uniformly from its own candidates, and the whole fleet is rejected on the
+ * first overlap rather than redrawing just the boat that overlaps. Redrawing would favour fleets
+ * whose later boats have few free placements, while rejecting keeps every consistent fleet
+ * equally likely, as FieldExact counts them. Drawing the most constrained boats first makes the
+ * rejections come early.
+ */
+static uint8_t FieldMCSample(const FieldMCJob *job, FieldMCWorker *worker)
+{
+    FieldMask taken;
+    int i;
+    FieldMaskClear(&taken);
+    for (i = 0; i < job->boats; i++) {
+        uint8_t type = job->order[i];
+        uint16_t p = job->candidates[type][RandomBelow(&worker->rng, job->count[type])];
+        if (FieldMaskIntersects(&fieldPlacements[p].mask, &taken)) {
+            return FALSE;
+        }
+        taken = FieldMaskOr(taken, fieldPlacements[p].mask);
+    }
+    FieldMask uncovered = FieldMaskAndNot(job->mustCover, taken);
+    if (!FieldMaskIsEmpty(&uncovered)) {
+        return FALSE;
+    }
+    taken = FieldMaskAnd(taken, job->unknown);
+    while (!FieldMaskIsEmpty(&taken)) {
+        worker->occupied[FieldMaskPopLowest(&taken)]++;
+    }
+    return TRUE;
+}
+
+static void *FieldMCWork(void *arg)
+{
+    FieldMCWorker *worker = arg;
+    const FieldMCJob *job = worker->job;
+    do {
+        int i;
+        for (i = 0; i < FIELD_MC_BATCH; i++) {
+            worker->samples += FieldMCSample(job, worker);
+        }
+    } while ((uint32_t) (BOARD_GetCoreTimer() - job->start) < job->budget);
+    return NULL;
+}
+
+/**
+ * Fills in the placements each boat may be drawn from. Returns FALSE if some boat has none.
+ */
+static uint8_t FieldMCPrepare(FieldMCJob *job, const Field *opp_field)
+{
+    FieldMask blocked = FieldAIBlockedSquares(opp_field);
+    FieldMask resolved;
+    uint8_t alive = FieldGetBoatStates(opp_field);
+    int type, p, pass;
+
+    FieldMaskClear(&resolved);
+    for (type = 0; type < FIELD_NUM_BOATS; type++) {
+        resolved = FieldMaskOr(resolved, opp_field->boats[type]);
+    }
+    job->mustCover = FieldMaskAndNot(opp_field->hit, resolved);
+    job->unknown = opp_field->unknown;
+    job->boats = 0;
+
+    // Sunk boats that were never pinned down go first, as they have the fewest placements: they
+    // lie entirely on unexplained hits. Live boats follow, largest first.
+    for (pass = 0; pass < 2; pass++) {
+        for (type = FIELD_BOAT_TYPE_HUGE; type >= FIELD_BOAT_TYPE_SMALL; type--) {
+            uint8_t sunk = !(alive & (1 << type));
+            if (sunk != (pass == 0) || (sunk && !FieldMaskIsEmpty(&opp_field->boats[type]))) {
+                continue;
+            }
+            job->count[type] = 0;
+            for (p = fieldPlacementStart[type]; p < fieldPlacementStart[type + 1]; p++) {
+                const FieldMask *mask = &fieldPlacements[p].mask;
+                FieldMask unexplained = FieldMaskAndNot(*mask, job->mustCover);
+                if (sunk ? FieldMaskIsEmpty(&unexplained) :
+                        FieldAIPlacementWeight(mask, &blocked, &opp_field->hit) != 0) {
+                    job->candidates[type][job->count[type]++] = p;
+                }
+            }
+            if (job->count[type] == 0) {
+                return FALSE;
+            }
+            job->order[job->boats++] = type;
+        }
+    }
+    return TRUE;
+}
+
+uint32_t FieldMCCountOccupied(const Field *opp_field, RandomState *rng, uint32_t budget,
+        uint32_t occupied[FIELD_NUM_SQUARES])
+{
+#ifdef PIC32
+    // One thread, and a stack that also has to hold the caller's occupied[]: the job's candidate
+    // lists alone are over 2KB, so they are kept off it.
+    static FieldMCJob job;
+    static FieldMCWorker workers[1];
+    FieldMCWorker *worker = workers;
+#else
+    FieldMCJob job;
+    FieldMCWorker *worker;
+#endif
+    uint32_t samples;
+    int threads = 1;
+    int i, w;
+
+    job.start = BOARD_GetCoreTimer();
+    job.budget = budget;
+    memset(occupied, 0, FIELD_NUM_SQUARES * sizeof (occupied[0]));
+    if (budget == 0 || !FieldMCPrepare(&job, opp_field)) {
+        return 0;
+    }
+
+#ifndef PIC32
+    // More threads than CPUs would only add preemption delays to the deadline.
+    threads = FieldMCUsableCpus();
+    if (FIELD_MC_THREADS > 0 && FIELD_MC_THREADS < threads) {
+        threads = FIELD_MC_THREADS;
+    }
+    worker = calloc(threads, sizeof (*worker));
+    if (worker == NULL) {
+        return 0;
+    }
+#else
+    memset(worker, 0, sizeof (*worker));
+#endif
+    for (w = 0; w < threads; w++) {
+        worker[w].job = &job;
+        // Each stream is seeded from the caller's, so a seeded game samples reproducibly.
+        RandomSeed(&worker[w].rng, RandomNext(rng));
+    }
+
+#ifndef PIC32
+    int started;
+    for (started = 1; started < threads; started++) {
+        if (pthread_create(&worker[started].thread, NULL, FieldMCWork, &worker[started]) != 0) {
+            break;
+        }
+    }
+    FieldMCWork(&worker[0]);
+    for (w = 1; w < started; w++) {
+        pthread_join(worker[w].thread, NULL);
+    }
+    threads = started;
+#else
+    FieldMCWork(&worker[0]);
+#endif
+
+    samples = 0;
+    for (w = 0; w < threads; w++) {
+        samples += worker[w].samples;
+        for (i = 0; i < FIELD_NUM_SQUARES; i++) {
+            occupied[i] += worker[w].occupied[i];
+        }
+    }
+#ifndef PIC32
+    free(worker);
+#endif
+    return samples;
+}
+
+GuessData FieldAIDecideGuessWithin(const Field *opp_field, RandomState *rng, uint32_t budget,
+        uint32_t *samples)
+{
+    uint32_t occupied[FIELD_NUM_SQUARES];
+    uint32_t drawn = FieldMCCountOccupied(opp_field, rng, budget, occupied);
+
+    if (samples) {
+        *samples = drawn;
+    }
+    if (drawn == 0) {
+        return FieldAIDecideGuessWith(opp_field, rng);
+    }
+    return FieldAIPickDensest(opp_field, occupied, rng);
+}
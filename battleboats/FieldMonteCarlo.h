@@ -0,0 +1,51 @@
+#ifndef FIELD_MONTE_CARLO_H
+#define FIELD_MONTE_CARLO_H
+
+#include <stdint.h>
+#include "Field.h"
+
+/**
+ * A Monte Carlo alternative to FieldAIDecideGuess() whose running time is set by the caller.
+ * Until the budget runs out it draws random fleets, every fleet that fits what is known about the
+ * opponent's field equally likely: no boat on a miss or on a pinned sunk boat, sunk boats on hits
+ * only, and every other hit covered. Then it shoots the unknown square that was occupied most
+ * often. More time means more
+ * samples and a better estimate, but the latency of each SHO stays bounded.
+ *
+ * Budgets are measured in CP0 core timer ticks, as read by BOARD_GetCoreTimer(). On the host,
+ * sampling is spread over one worker thread per usable CPU (or FIELD_MC_THREADS, if that is
+ * fewer), each with its own random stream seeded from the caller's. The PIC32 samples on the
+ * calling thread and simply gets fewer samples in the same budget.
+ */
+
+#ifndef FIELD_MC_THREADS
+#define FIELD_MC_THREADS 0
+#endif
+
+/**
+ * Samples fleets for `budget` core timer ticks, as FieldAIDecideGuessWithin() does, and counts in
+ * `occupied` how many of them cover each unknown square. Divided by the number of fleets, these
+ * estimate the probability that each square holds a boat.
+ *
+ * @return The number of fleets drawn, 0 for a zero budget or a field no fleet can fit.
+ */
+uint32_t FieldMCCountOccupied(const Field *opp_field, RandomState *rng, uint32_t budget,
+        uint32_t occupied[FIELD_NUM_SQUARES]);
+
+/**
+ * Decides the next guess by sampling fleets for `budget` core timer ticks, e.g.
+ * 5 * BOARD_CORE_TICKS_PER_MS for 5ms.
+ *
+ * If no fleet could be drawn in time (a zero budget, or a position where random fleets rarely
+ * fit), this falls back to FieldAIDecideGuessWith().
+ *
+ * @param opp_field The opponent's field.
+ * @param rng       Seeds the sampling streams and breaks ties.
+ * @param budget    The time allowed, in core timer ticks.
+ * @param samples   If not NULL, receives the number of fleets drawn.
+ * @return a GuessData struct whose row and col parameters are the coordinates of the guess.
+ */
+GuessData FieldAIDecideGuessWithin(const Field *opp_field, RandomState *rng, uint32_t budget,
+        uint32_t *samples);
+
+#endif // FIELD_MONTE_CARLO_H
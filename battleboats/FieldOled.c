@@ -138,7 +138,7 @@ void _FieldOledDrawField(const Field *f, int xOffset)
     for (i = 0; i < FIELD_COLS; ++i) {
         int j;
         for (j = 0; j < FIELD_ROWS; ++j) {
-            _FieldOledDrawSymbol(xOffset + 1 + 5 * i, yOffset + 5 * j, f->grid[j][i]);
+            _FieldOledDrawSymbol(xOffset + 1 + 5 * i, yOffset + 5 * j, FieldGetSquareStatus(f, j, i));
         }
     }
 }
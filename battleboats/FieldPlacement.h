@@ -0,0 +1,118 @@
+#ifndef FIELD_PLACEMENT_H
+#define FIELD_PLACEMENT_H
+
+#include <stdint.h>
+#include "Field.h"
+
+/**
+ * A table of every legal placement of every boat on the field, generated at build time by
+ * FieldPlacementGen.c into FieldPlacementTable.c. Being const, the table lives in flash.
+ *
+ * The placements of each BoatType are stored contiguously, in the range
+ * [fieldPlacementStart[type], fieldPlacementStart[type + 1]). Within a type, all FIELD_DIR_EAST
+ * placements come first in row-major order of their starting square, followed by all
+ * FIELD_DIR_SOUTH placements in the same order.
+ *
+ * To regenerate the table for a different field size, run (from the battleboats directory):
+ *   make placement-table FIELD_ROWS=8 FIELD_COLS=12
+ * and build the firmware with the same FIELD_ROWS/FIELD_COLS definitions.
+ */
+
+/**
+ * The number of placements of a boat of length `len` in each direction.
+ */
+#define FIELD_PLACEMENTS_EAST(len) ((FIELD_COLS >= (len)) ? FIELD_ROWS * (FIELD_COLS - (len) + 1) : 0)
+#define FIELD_PLACEMENTS_SOUTH(len) ((FIELD_ROWS >= (len)) ? (FIELD_ROWS - (len) + 1) * FIELD_COLS : 0)
+#define FIELD_PLACEMENTS_FOR(len) (FIELD_PLACEMENTS_EAST(len) + FIELD_PLACEMENTS_SOUTH(len))
+
+#define FIELD_NUM_PLACEMENTS (FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_SMALL) + \
+                              FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_MEDIUM) + \
+                              FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_LARGE) + \
+                              FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_HUGE))
+
+/**
+ * A single legal placement: the squares it covers, and the FieldAddBoat() arguments that
+ * produce it.
+ */
+typedef struct {
+    FieldMask mask;
+    uint8_t row;
+    uint8_t col;
+    uint8_t dir; // A BoatDirection
+} FieldPlacement;
+
+extern const FieldPlacement fieldPlacements[FIELD_NUM_PLACEMENTS];
+extern const uint16_t fieldPlacementStart[FIELD_NUM_BOATS + 1];
+
+/**
+ * Counts of non-overlapping fleets on an empty field, used to sample a fleet uniformly at random
+ * one boat at a time (HUGE, then LARGE, then MEDIUM, then SMALL) without rejection:
+ *
+ *   fieldFleetTotal                 the number of distinct fleets.
+ *   fieldFleetCountHuge[h]          the number of fleets whose HUGE boat is at placement h.
+ *   fieldFleetCountHugeLarge[h][l]  the number of fleets with HUGE at h and LARGE at l (0 if
+ *                                   they overlap).
+ *
+ * h and l are relative to the first placement of their BoatType.
+ */
+#define FIELD_NUM_HUGE_PLACEMENTS FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_HUGE)
+#define FIELD_NUM_LARGE_PLACEMENTS FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_LARGE)
+
+extern const uint32_t fieldFleetTotal;
+extern const uint32_t fieldFleetCountHuge[FIELD_NUM_HUGE_PLACEMENTS];
+extern const uint32_t fieldFleetCountHugeLarge[FIELD_NUM_HUGE_PLACEMENTS][FIELD_NUM_LARGE_PLACEMENTS];
+
+/**
+ * For each square, the indices of the placements that cover it, so that a shot only has to look
+ * at the placements it can affect. The indices for square `s` (a FieldSquareIndex()) are
+ * fieldSquarePlacements[fieldSquarePlacementStart[s]] up to, but not including,
+ * fieldSquarePlacements[fieldSquarePlacementStart[s + 1]], in ascending order.
+ */
+#define FIELD_NUM_PLACEMENT_SQUARES (FIELD_BOAT_SIZE_SMALL * FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_SMALL) + \
+                                     FIELD_BOAT_SIZE_MEDIUM * FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_MEDIUM) + \
+                                     FIELD_BOAT_SIZE_LARGE * FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_LARGE) + \
+                                     FIELD_BOAT_SIZE_HUGE * FIELD_PLACEMENTS_FOR(FIELD_BOAT_SIZE_HUGE))
+
+extern const uint16_t fieldSquarePlacementStart[FIELD_NUM_SQUARES + 1];
+extern const uint16_t fieldSquarePlacements[FIELD_NUM_PLACEMENT_SQUARES];
+
+/**
+ * Returns the BoatType of the placement at index `p` in fieldPlacements.
+ */
+static inline BoatType FieldPlacementType(uint16_t p)
+{
+    BoatType type = FIELD_BOAT_TYPE_SMALL;
+    while (type < FIELD_BOAT_TYPE_HUGE && p >= fieldPlacementStart[type + 1]) {
+        type++;
+    }
+    return type;
+}
+
+/**
+ * Looks up the table index of a placement.
+ * @return The index into fieldPlacements, or -1 if the boat would not fit on the field there.
+ */
+static inline int FieldPlacementFind(BoatType type, uint8_t row, uint8_t col, BoatDirection dir)
+{
+    static const uint8_t lengths[FIELD_NUM_BOATS] = {
+        FIELD_BOAT_SIZE_SMALL, FIELD_BOAT_SIZE_MEDIUM, FIELD_BOAT_SIZE_LARGE, FIELD_BOAT_SIZE_HUGE
+    };
+    if (type > FIELD_BOAT_TYPE_HUGE) {
+        return -1;
+    }
+    uint8_t len = lengths[type];
+    if (dir == FIELD_DIR_EAST) {
+        if (row >= FIELD_ROWS || col + len > FIELD_COLS) {
+            return -1;
+        }
+        return fieldPlacementStart[type] + row * (FIELD_COLS - len + 1) + col;
+    } else if (dir == FIELD_DIR_SOUTH) {
+        if (row + len > FIELD_ROWS || col >= FIELD_COLS) {
+            return -1;
+        }
+        return fieldPlacementStart[type] + FIELD_PLACEMENTS_EAST(len) + row * FIELD_COLS + col;
+    }
+    return -1;
+}
+
+#endif // FIELD_PLACEMENT_H
@@ -0,0 +1,208 @@
+/*
+ * File:   FieldPlacementGen.c
+ *
+ * Host-side generator for FieldPlacementTable.c. It is compiled with the same FIELD_ROWS and
+ * FIELD_COLS as the firmware, and writes the table of every legal boat placement, the
+ * placements covering each square, and the fleet counts used for uniform fleet placement, to
+ * stdout:
+ *
+ *   cc -DFIELD_ROWS=6 -DFIELD_COLS=10 FieldPlacementGen.c -o FieldPlacementGen
+ *   ./FieldPlacementGen > FieldPlacementTable.c
+ *
+ * `make placement-table` does both steps.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Field.h"
+#include "FieldPlacement.h"
+
+static const uint8_t boatLengths[FIELD_NUM_BOATS] = {
+    FIELD_BOAT_SIZE_SMALL, FIELD_BOAT_SIZE_MEDIUM, FIELD_BOAT_SIZE_LARGE, FIELD_BOAT_SIZE_HUGE
+};
+
+static const char *boatNames[FIELD_NUM_BOATS] = {
+    "FIELD_BOAT_TYPE_SMALL", "FIELD_BOAT_TYPE_MEDIUM", "FIELD_BOAT_TYPE_LARGE", "FIELD_BOAT_TYPE_HUGE"
+};
+
+static int emitted = 0;
+static FieldPlacement placements[FIELD_NUM_PLACEMENTS];
+static uint16_t placementStart[FIELD_NUM_BOATS + 1];
+
+static void EmitPlacement(uint8_t row, uint8_t col, BoatDirection dir, uint8_t len)
+{
+    FieldMask mask;
+    int i;
+    FieldMaskClear(&mask);
+    for (i = 0; i < len; i++) {
+        if (dir == FIELD_DIR_EAST) {
+            FieldMaskSet(&mask, FieldSquareIndex(row, col + i));
+        } else {
+            FieldMaskSet(&mask, FieldSquareIndex(row + i, col));
+        }
+    }
+    printf("    {{{");
+    for (i = 0; i < FIELD_MASK_WORDS; i++) {
+        printf("%s0x%016llXULL", i ? ", " : "", (unsigned long long) mask.word[i]);
+    }
+    printf("}}, %u, %u, %s},\n", row, col, dir == FIELD_DIR_EAST ? "FIELD_DIR_EAST" : "FIELD_DIR_SOUTH");
+    placements[emitted].mask = mask;
+    placements[emitted].row = row;
+    placements[emitted].col = col;
+    placements[emitted].dir = dir;
+    emitted++;
+}
+
+/**
+ * Emits the per-square placement lists described in FieldPlacement.h.
+ */
+static int EmitSquarePlacements(void)
+{
+    int square, p, total = 0;
+    printf("\nconst uint16_t fieldSquarePlacementStart[FIELD_NUM_SQUARES + 1] = {");
+    for (square = 0; square < FIELD_NUM_SQUARES; square++) {
+        printf("%s%d", square ? ((square % 12) ? ", " : ",\n    ") : "\n    ", total);
+        for (p = 0; p < FIELD_NUM_PLACEMENTS; p++) {
+            total += FieldMaskTest(&placements[p].mask, square);
+        }
+    }
+    printf(",\n    %d\n};\n", total);
+    if (total != FIELD_NUM_PLACEMENT_SQUARES || total > UINT16_MAX) {
+        fprintf(stderr, "FieldPlacementGen: %d placement squares do not fit the 16-bit tables\n", total);
+        return EXIT_FAILURE;
+    }
+
+    printf("\nconst uint16_t fieldSquarePlacements[FIELD_NUM_PLACEMENT_SQUARES] = {");
+    for (square = 0; square < FIELD_NUM_SQUARES; square++) {
+        int n = 0;
+        printf("\n    // Square %d", square);
+        for (p = 0; p < FIELD_NUM_PLACEMENTS; p++) {
+            if (FieldMaskTest(&placements[p].mask, square)) {
+                printf("%s%d,", (n++ % 12) ? " " : "\n    ", p);
+            }
+        }
+    }
+    printf("\n};\n");
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Counts the (MEDIUM, SMALL) pairs that fit alongside the squares in `taken`.
+ */
+static uint64_t CountMediumSmall(FieldMask taken)
+{
+    uint64_t count = 0;
+    int m, s;
+    for (m = placementStart[FIELD_BOAT_TYPE_MEDIUM]; m < placementStart[FIELD_BOAT_TYPE_MEDIUM + 1]; m++) {
+        if (FieldMaskIntersects(&placements[m].mask, &taken)) {
+            continue;
+        }
+        FieldMask withMedium = FieldMaskOr(taken, placements[m].mask);
+        for (s = placementStart[FIELD_BOAT_TYPE_SMALL]; s < placementStart[FIELD_BOAT_TYPE_SMALL + 1]; s++) {
+            if (!FieldMaskIntersects(&placements[s].mask, &withMedium)) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * Emits the fleet counts described in FieldPlacement.h.
+ */
+static int EmitFleetCounts(void)
+{
+    static uint64_t hugeLarge[FIELD_NUM_HUGE_PLACEMENTS][FIELD_NUM_LARGE_PLACEMENTS];
+    uint64_t huge[FIELD_NUM_HUGE_PLACEMENTS];
+    uint64_t total = 0;
+    int h, l;
+    for (h = 0; h < FIELD_NUM_HUGE_PLACEMENTS; h++) {
+        const FieldMask *hugeMask = &placements[placementStart[FIELD_BOAT_TYPE_HUGE] + h].mask;
+        huge[h] = 0;
+        for (l = 0; l < FIELD_NUM_LARGE_PLACEMENTS; l++) {
+            const FieldMask *largeMask = &placements[placementStart[FIELD_BOAT_TYPE_LARGE] + l].mask;
+            hugeLarge[h][l] = 0;
+            if (!FieldMaskIntersects(hugeMask, largeMask)) {
+                hugeLarge[h][l] = CountMediumSmall(FieldMaskOr(*hugeMask, *largeMask));
+            }
+            huge[h] += hugeLarge[h][l];
+        }
+        total += huge[h];
+    }
+    if (total > UINT32_MAX) {
+        fprintf(stderr, "FieldPlacementGen: %llu fleets overflow the 32-bit counts\n",
+                (unsigned long long) total);
+        return EXIT_FAILURE;
+    }
+
+    printf("\nconst uint32_t fieldFleetTotal = %lluUL;\n", (unsigned long long) total);
+    printf("\nconst uint32_t fieldFleetCountHuge[FIELD_NUM_HUGE_PLACEMENTS] = {");
+    for (h = 0; h < FIELD_NUM_HUGE_PLACEMENTS; h++) {
+        printf("%s%llu", h ? ((h % 8) ? ", " : ",\n    ") : "\n    ", (unsigned long long) huge[h]);
+    }
+    printf("\n};\n");
+    printf("\nconst uint32_t fieldFleetCountHugeLarge[FIELD_NUM_HUGE_PLACEMENTS][FIELD_NUM_LARGE_PLACEMENTS] = {\n");
+    for (h = 0; h < FIELD_NUM_HUGE_PLACEMENTS; h++) {
+        printf("    {");
+        for (l = 0; l < FIELD_NUM_LARGE_PLACEMENTS; l++) {
+            printf("%s%llu", l ? ((l % 12) ? ", " : ",\n     ") : "", (unsigned long long) hugeLarge[h][l]);
+        }
+        printf("},\n");
+    }
+    printf("};\n");
+    return EXIT_SUCCESS;
+}
+
+int main(void)
+{
+    int type, row, col;
+    uint16_t start = 0;
+
+    printf("/*\n");
+    printf(" * File:   FieldPlacementTable.c\n");
+    printf(" *\n");
+    printf(" * GENERATED by FieldPlacementGen.c for a %dx%d field -- do not edit.\n", FIELD_ROWS, FIELD_COLS);
+    printf(" * Regenerate with `make placement-table FIELD_ROWS=<rows> FIELD_COLS=<cols>`.\n");
+    printf(" */\n\n");
+    printf("#include \"FieldPlacement.h\"\n\n");
+    printf("#if FIELD_ROWS != %d || FIELD_COLS != %d\n", FIELD_ROWS, FIELD_COLS);
+    printf("#error \"FieldPlacementTable.c was generated for a %dx%d field, regenerate it with "
+            "make placement-table\"\n", FIELD_ROWS, FIELD_COLS);
+    printf("#endif\n\n");
+
+    printf("const uint16_t fieldPlacementStart[FIELD_NUM_BOATS + 1] = {");
+    for (type = 0; type < FIELD_NUM_BOATS; type++) {
+        printf("%u, ", start);
+        placementStart[type] = start;
+        start += FIELD_PLACEMENTS_FOR(boatLengths[type]);
+    }
+    placementStart[FIELD_NUM_BOATS] = start;
+    printf("%u};\n\n", start);
+
+    printf("const FieldPlacement fieldPlacements[FIELD_NUM_PLACEMENTS] = {\n");
+    for (type = 0; type < FIELD_NUM_BOATS; type++) {
+        uint8_t len = boatLengths[type];
+        printf("    // %s\n", boatNames[type]);
+        for (row = 0; row < FIELD_ROWS; row++) {
+            for (col = 0; col + len <= FIELD_COLS; col++) {
+                EmitPlacement(row, col, FIELD_DIR_EAST, len);
+            }
+        }
+        for (row = 0; row + len <= FIELD_ROWS; row++) {
+            for (col = 0; col < FIELD_COLS; col++) {
+                EmitPlacement(row, col, FIELD_DIR_SOUTH, len);
+            }
+        }
+    }
+    printf("};\n");
+
+    if (emitted != FIELD_NUM_PLACEMENTS) {
+        fprintf(stderr, "FieldPlacementGen: emitted %d placements, expected %d\n",
+                emitted, FIELD_NUM_PLACEMENTS);
+        return EXIT_FAILURE;
+    }
+    if (EmitSquarePlacements() != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    return EmitFleetCounts();
+}
@@ -0,0 +1,674 @@
+/*
+ * File:   FieldPlacementTable.c
+ *
+ * GENERATED by FieldPlacementGen.c for a 6x10 field -- do not edit.
+ * Regenerate with `make placement-table FIELD_ROWS=<rows> FIELD_COLS=<cols>`.
+ */
+
+#include "FieldPlacement.h"
+
+#if FIELD_ROWS != 6 || FIELD_COLS != 10
+#error "FieldPlacementTable.c was generated for a 6x10 field, regenerate it with make placement-table"
+#endif
+
+const uint16_t fieldPlacementStart[FIELD_NUM_BOATS + 1] = {0, 88, 160, 216, 256};
+
+const FieldPlacement fieldPlacements[FIELD_NUM_PLACEMENTS] = {
+    // FIELD_BOAT_TYPE_SMALL
+    {{{0x0000000000000007ULL}}, 0, 0, FIELD_DIR_EAST},
+    {{{0x000000000000000EULL}}, 0, 1, FIELD_DIR_EAST},
+    {{{0x000000000000001CULL}}, 0, 2, FIELD_DIR_EAST},
+    {{{0x0000000000000038ULL}}, 0, 3, FIELD_DIR_EAST},
+    {{{0x0000000000000070ULL}}, 0, 4, FIELD_DIR_EAST},
+    {{{0x00000000000000E0ULL}}, 0, 5, FIELD_DIR_EAST},
+    {{{0x00000000000001C0ULL}}, 0, 6, FIELD_DIR_EAST},
+    {{{0x0000000000000380ULL}}, 0, 7, FIELD_DIR_EAST},
+    {{{0x0000000000001C00ULL}}, 1, 0, FIELD_DIR_EAST},
+    {{{0x0000000000003800ULL}}, 1, 1, FIELD_DIR_EAST},
+    {{{0x0000000000007000ULL}}, 1, 2, FIELD_DIR_EAST},
+    {{{0x000000000000E000ULL}}, 1, 3, FIELD_DIR_EAST},
+    {{{0x000000000001C000ULL}}, 1, 4, FIELD_DIR_EAST},
+    {{{0x0000000000038000ULL}}, 1, 5, FIELD_DIR_EAST},
+    {{{0x0000000000070000ULL}}, 1, 6, FIELD_DIR_EAST},
+    {{{0x00000000000E0000ULL}}, 1, 7, FIELD_DIR_EAST},
+    {{{0x0000000000700000ULL}}, 2, 0, FIELD_DIR_EAST},
+    {{{0x0000000000E00000ULL}}, 2, 1, FIELD_DIR_EAST},
+    {{{0x0000000001C00000ULL}}, 2, 2, FIELD_DIR_EAST},
+    {{{0x0000000003800000ULL}}, 2, 3, FIELD_DIR_EAST},
+    {{{0x0000000007000000ULL}}, 2, 4, FIELD_DIR_EAST},
+    {{{0x000000000E000000ULL}}, 2, 5, FIELD_DIR_EAST},
+    {{{0x000000001C000000ULL}}, 2, 6, FIELD_DIR_EAST},
+    {{{0x0000000038000000ULL}}, 2, 7, FIELD_DIR_EAST},
+    {{{0x00000001C0000000ULL}}, 3, 0, FIELD_DIR_EAST},
+    {{{0x0000000380000000ULL}}, 3, 1, FIELD_DIR_EAST},
+    {{{0x0000000700000000ULL}}, 3, 2, FIELD_DIR_EAST},
+    {{{0x0000000E00000000ULL}}, 3, 3, FIELD_DIR_EAST},
+    {{{0x0000001C00000000ULL}}, 3, 4, FIELD_DIR_EAST},
+    {{{0x0000003800000000ULL}}, 3, 5, FIELD_DIR_EAST},
+    {{{0x0000007000000000ULL}}, 3, 6, FIELD_DIR_EAST},
+    {{{0x000000E000000000ULL}}, 3, 7, FIELD_DIR_EAST},
+    {{{0x0000070000000000ULL}}, 4, 0, FIELD_DIR_EAST},
+    {{{0x00000E0000000000ULL}}, 4, 1, FIELD_DIR_EAST},
+    {{{0x00001C0000000000ULL}}, 4, 2, FIELD_DIR_EAST},
+    {{{0x0000380000000000ULL}}, 4, 3, FIELD_DIR_EAST},
+    {{{0x0000700000000000ULL}}, 4, 4, FIELD_DIR_EAST},
+    {{{0x0000E00000000000ULL}}, 4, 5, FIELD_DIR_EAST},
+    {{{0x0001C00000000000ULL}}, 4, 6, FIELD_DIR_EAST},
+    {{{0x0003800000000000ULL}}, 4, 7, FIELD_DIR_EAST},
+    {{{0x001C000000000000ULL}}, 5, 0, FIELD_DIR_EAST},
+    {{{0x0038000000000000ULL}}, 5, 1, FIELD_DIR_EAST},
+    {{{0x0070000000000000ULL}}, 5, 2, FIELD_DIR_EAST},
+    {{{0x00E0000000000000ULL}}, 5, 3, FIELD_DIR_EAST},
+    {{{0x01C0000000000000ULL}}, 5, 4, FIELD_DIR_EAST},
+    {{{0x0380000000000000ULL}}, 5, 5, FIELD_DIR_EAST},
+    {{{0x0700000000000000ULL}}, 5, 6, FIELD_DIR_EAST},
+    {{{0x0E00000000000000ULL}}, 5, 7, FIELD_DIR_EAST},
+    {{{0x0000000000100401ULL}}, 0, 0, FIELD_DIR_SOUTH},
+    {{{0x0000000000200802ULL}}, 0, 1, FIELD_DIR_SOUTH},
+    {{{0x0000000000401004ULL}}, 0, 2, FIELD_DIR_SOUTH},
+    {{{0x0000000000802008ULL}}, 0, 3, FIELD_DIR_SOUTH},
+    {{{0x0000000001004010ULL}}, 0, 4, FIELD_DIR_SOUTH},
+    {{{0x0000000002008020ULL}}, 0, 5, FIELD_DIR_SOUTH},
+    {{{0x0000000004010040ULL}}, 0, 6, FIELD_DIR_SOUTH},
+    {{{0x0000000008020080ULL}}, 0, 7, FIELD_DIR_SOUTH},
+    {{{0x0000000010040100ULL}}, 0, 8, FIELD_DIR_SOUTH},
+    {{{0x0000000020080200ULL}}, 0, 9, FIELD_DIR_SOUTH},
+    {{{0x0000000040100400ULL}}, 1, 0, FIELD_DIR_SOUTH},
+    {{{0x0000000080200800ULL}}, 1, 1, FIELD_DIR_SOUTH},
+    {{{0x0000000100401000ULL}}, 1, 2, FIELD_DIR_SOUTH},
+    {{{0x0000000200802000ULL}}, 1, 3, FIELD_DIR_SOUTH},
+    {{{0x0000000401004000ULL}}, 1, 4, FIELD_DIR_SOUTH},
+    {{{0x0000000802008000ULL}}, 1, 5, FIELD_DIR_SOUTH},
+    {{{0x0000001004010000ULL}}, 1, 6, FIELD_DIR_SOUTH},
+    {{{0x0000002008020000ULL}}, 1, 7, FIELD_DIR_SOUTH},
+    {{{0x0000004010040000ULL}}, 1, 8, FIELD_DIR_SOUTH},
+    {{{0x0000008020080000ULL}}, 1, 9, FIELD_DIR_SOUTH},
+    {{{0x0000010040100000ULL}}, 2, 0, FIELD_DIR_SOUTH},
+    {{{0x0000020080200000ULL}}, 2, 1, FIELD_DIR_SOUTH},
+    {{{0x0000040100400000ULL}}, 2, 2, FIELD_DIR_SOUTH},
+    {{{0x0000080200800000ULL}}, 2, 3, FIELD_DIR_SOUTH},
+    {{{0x0000100401000000ULL}}, 2, 4, FIELD_DIR_SOUTH},
+    {{{0x0000200802000000ULL}}, 2, 5, FIELD_DIR_SOUTH},
+    {{{0x0000401004000000ULL}}, 2, 6, FIELD_DIR_SOUTH},
+    {{{0x0000802008000000ULL}}, 2, 7, FIELD_DIR_SOUTH},
+    {{{0x0001004010000000ULL}}, 2, 8, FIELD_DIR_SOUTH},
+    {{{0x0002008020000000ULL}}, 2, 9, FIELD_DIR_SOUTH},
+    {{{0x0004010040000000ULL}}, 3, 0, FIELD_DIR_SOUTH},
+    {{{0x0008020080000000ULL}}, 3, 1, FIELD_DIR_SOUTH},
+    {{{0x0010040100000000ULL}}, 3, 2, FIELD_DIR_SOUTH},
+    {{{0x0020080200000000ULL}}, 3, 3, FIELD_DIR_SOUTH},
+    {{{0x0040100400000000ULL}}, 3, 4, FIELD_DIR_SOUTH},
+    {{{0x0080200800000000ULL}}, 3, 5, FIELD_DIR_SOUTH},
+    {{{0x0100401000000000ULL}}, 3, 6, FIELD_DIR_SOUTH},
+    {{{0x0200802000000000ULL}}, 3, 7, FIELD_DIR_SOUTH},
+    {{{0x0401004000000000ULL}}, 3, 8, FIELD_DIR_SOUTH},
+    {{{0x0802008000000000ULL}}, 3, 9, FIELD_DIR_SOUTH},
+    // FIELD_BOAT_TYPE_MEDIUM
+    {{{0x000000000000000FULL}}, 0, 0, FIELD_DIR_EAST},
+    {{{0x000000000000001EULL}}, 0, 1, FIELD_DIR_EAST},
+    {{{0x000000000000003CULL}}, 0, 2, FIELD_DIR_EAST},
+    {{{0x0000000000000078ULL}}, 0, 3, FIELD_DIR_EAST},
+    {{{0x00000000000000F0ULL}}, 0, 4, FIELD_DIR_EAST},
+    {{{0x00000000000001E0ULL}}, 0, 5, FIELD_DIR_EAST},
+    {{{0x00000000000003C0ULL}}, 0, 6, FIELD_DIR_EAST},
+    {{{0x0000000000003C00ULL}}, 1, 0, FIELD_DIR_EAST},
+    {{{0x0000000000007800ULL}}, 1, 1, FIELD_DIR_EAST},
+    {{{0x000000000000F000ULL}}, 1, 2, FIELD_DIR_EAST},
+    {{{0x000000000001E000ULL}}, 1, 3, FIELD_DIR_EAST},
+    {{{0x000000000003C000ULL}}, 1, 4, FIELD_DIR_EAST},
+    {{{0x0000000000078000ULL}}, 1, 5, FIELD_DIR_EAST},
+    {{{0x00000000000F0000ULL}}, 1, 6, FIELD_DIR_EAST},
+    {{{0x0000000000F00000ULL}}, 2, 0, FIELD_DIR_EAST},
+    {{{0x0000000001E00000ULL}}, 2, 1, FIELD_DIR_EAST},
+    {{{0x0000000003C00000ULL}}, 2, 2, FIELD_DIR_EAST},
+    {{{0x0000000007800000ULL}}, 2, 3, FIELD_DIR_EAST},
+    {{{0x000000000F000000ULL}}, 2, 4, FIELD_DIR_EAST},
+    {{{0x000000001E000000ULL}}, 2, 5, FIELD_DIR_EAST},
+    {{{0x000000003C000000ULL}}, 2, 6, FIELD_DIR_EAST},
+    {{{0x00000003C0000000ULL}}, 3, 0, FIELD_DIR_EAST},
+    {{{0x0000000780000000ULL}}, 3, 1, FIELD_DIR_EAST},
+    {{{0x0000000F00000000ULL}}, 3, 2, FIELD_DIR_EAST},
+    {{{0x0000001E00000000ULL}}, 3, 3, FIELD_DIR_EAST},
+    {{{0x0000003C00000000ULL}}, 3, 4, FIELD_DIR_EAST},
+    {{{0x0000007800000000ULL}}, 3, 5, FIELD_DIR_EAST},
+    {{{0x000000F000000000ULL}}, 3, 6, FIELD_DIR_EAST},
+    {{{0x00000F0000000000ULL}}, 4, 0, FIELD_DIR_EAST},
+    {{{0x00001E0000000000ULL}}, 4, 1, FIELD_DIR_EAST},
+    {{{0x00003C0000000000ULL}}, 4, 2, FIELD_DIR_EAST},
+    {{{0x0000780000000000ULL}}, 4, 3, FIELD_DIR_EAST},
+    {{{0x0000F00000000000ULL}}, 4, 4, FIELD_DIR_EAST},
+    {{{0x0001E00000000000ULL}}, 4, 5, FIELD_DIR_EAST},
+    {{{0x0003C00000000000ULL}}, 4, 6, FIELD_DIR_EAST},
+    {{{0x003C000000000000ULL}}, 5, 0, FIELD_DIR_EAST},
+    {{{0x0078000000000000ULL}}, 5, 1, FIELD_DIR_EAST},
+    {{{0x00F0000000000000ULL}}, 5, 2, FIELD_DIR_EAST},
+    {{{0x01E0000000000000ULL}}, 5, 3, FIELD_DIR_EAST},
+    {{{0x03C0000000000000ULL}}, 5, 4, FIELD_DIR_EAST},
+    {{{0x0780000000000000ULL}}, 5, 5, FIELD_DIR_EAST},
+    {{{0x0F00000000000000ULL}}, 5, 6, FIELD_DIR_EAST},
+    {{{0x0000000040100401ULL}}, 0, 0, FIELD_DIR_SOUTH},
+    {{{0x0000000080200802ULL}}, 0, 1, FIELD_DIR_SOUTH},
+    {{{0x0000000100401004ULL}}, 0, 2, FIELD_DIR_SOUTH},
+    {{{0x0000000200802008ULL}}, 0, 3, FIELD_DIR_SOUTH},
+    {{{0x0000000401004010ULL}}, 0, 4, FIELD_DIR_SOUTH},
+    {{{0x0000000802008020ULL}}, 0, 5, FIELD_DIR_SOUTH},
+    {{{0x0000001004010040ULL}}, 0, 6, FIELD_DIR_SOUTH},
+    {{{0x0000002008020080ULL}}, 0, 7, FIELD_DIR_SOUTH},
+    {{{0x0000004010040100ULL}}, 0, 8, FIELD_DIR_SOUTH},
+    {{{0x0000008020080200ULL}}, 0, 9, FIELD_DIR_SOUTH},
+    {{{0x0000010040100400ULL}}, 1, 0, FIELD_DIR_SOUTH},
+    {{{0x0000020080200800ULL}}, 1, 1, FIELD_DIR_SOUTH},
+    {{{0x0000040100401000ULL}}, 1, 2, FIELD_DIR_SOUTH},
+    {{{0x0000080200802000ULL}}, 1, 3, FIELD_DIR_SOUTH},
+    {{{0x0000100401004000ULL}}, 1, 4, FIELD_DIR_SOUTH},
+    {{{0x0000200802008000ULL}}, 1, 5, FIELD_DIR_SOUTH},
+    {{{0x0000401004010000ULL}}, 1, 6, FIELD_DIR_SOUTH},
+    {{{0x0000802008020000ULL}}, 1, 7, FIELD_DIR_SOUTH},
+    {{{0x0001004010040000ULL}}, 1, 8, FIELD_DIR_SOUTH},
+    {{{0x0002008020080000ULL}}, 1, 9, FIELD_DIR_SOUTH},
+    {{{0x0004010040100000ULL}}, 2, 0, FIELD_DIR_SOUTH},
+    {{{0x0008020080200000ULL}}, 2, 1, FIELD_DIR_SOUTH},
+    {{{0x0010040100400000ULL}}, 2, 2, FIELD_DIR_SOUTH},
+    {{{0x0020080200800000ULL}}, 2, 3, FIELD_DIR_SOUTH},
+    {{{0x0040100401000000ULL}}, 2, 4, FIELD_DIR_SOUTH},
+    {{{0x0080200802000000ULL}}, 2, 5, FIELD_DIR_SOUTH},
+    {{{0x0100401004000000ULL}}, 2, 6, FIELD_DIR_SOUTH},
+    {{{0x0200802008000000ULL}}, 2, 7, FIELD_DIR_SOUTH},
+    {{{0x0401004010000000ULL}}, 2, 8, FIELD_DIR_SOUTH},
+    {{{0x0802008020000000ULL}}, 2, 9, FIELD_DIR_SOUTH},
+    // FIELD_BOAT_TYPE_LARGE
+    {{{0x000000000000001FULL}}, 0, 0, FIELD_DIR_EAST},
+    {{{0x000000000000003EULL}}, 0, 1, FIELD_DIR_EAST},
+    {{{0x000000000000007CULL}}, 0, 2, FIELD_DIR_EAST},
+    {{{0x00000000000000F8ULL}}, 0, 3, FIELD_DIR_EAST},
+    {{{0x00000000000001F0ULL}}, 0, 4, FIELD_DIR_EAST},
+    {{{0x00000000000003E0ULL}}, 0, 5, FIELD_DIR_EAST},
+    {{{0x0000000000007C00ULL}}, 1, 0, FIELD_DIR_EAST},
+    {{{0x000000000000F800ULL}}, 1, 1, FIELD_DIR_EAST},
+    {{{0x000000000001F000ULL}}, 1, 2, FIELD_DIR_EAST},
+    {{{0x000000000003E000ULL}}, 1, 3, FIELD_DIR_EAST},
+    {{{0x000000000007C000ULL}}, 1, 4, FIELD_DIR_EAST},
+    {{{0x00000000000F8000ULL}}, 1, 5, FIELD_DIR_EAST},
+    {{{0x0000000001F00000ULL}}, 2, 0, FIELD_DIR_EAST},
+    {{{0x0000000003E00000ULL}}, 2, 1, FIELD_DIR_EAST},
+    {{{0x0000000007C00000ULL}}, 2, 2, FIELD_DIR_EAST},
+    {{{0x000000000F800000ULL}}, 2, 3, FIELD_DIR_EAST},
+    {{{0x000000001F000000ULL}}, 2, 4, FIELD_DIR_EAST},
+    {{{0x000000003E000000ULL}}, 2, 5, FIELD_DIR_EAST},
+    {{{0x00000007C0000000ULL}}, 3, 0, FIELD_DIR_EAST},
+    {{{0x0000000F80000000ULL}}, 3, 1, FIELD_DIR_EAST},
+    {{{0x0000001F00000000ULL}}, 3, 2, FIELD_DIR_EAST},
+    {{{0x0000003E00000000ULL}}, 3, 3, FIELD_DIR_EAST},
+    {{{0x0000007C00000000ULL}}, 3, 4, FIELD_DIR_EAST},
+    {{{0x000000F800000000ULL}}, 3, 5, FIELD_DIR_EAST},
+    {{{0x00001F0000000000ULL}}, 4, 0, FIELD_DIR_EAST},
+    {{{0x00003E0000000000ULL}}, 4, 1, FIELD_DIR_EAST},
+    {{{0x00007C0000000000ULL}}, 4, 2, FIELD_DIR_EAST},
+    {{{0x0000F80000000000ULL}}, 4, 3, FIELD_DIR_EAST},
+    {{{0x0001F00000000000ULL}}, 4, 4, FIELD_DIR_EAST},
+    {{{0x0003E00000000000ULL}}, 4, 5, FIELD_DIR_EAST},
+    {{{0x007C000000000000ULL}}, 5, 0, FIELD_DIR_EAST},
+    {{{0x00F8000000000000ULL}}, 5, 1, FIELD_DIR_EAST},
+    {{{0x01F0000000000000ULL}}, 5, 2, FIELD_DIR_EAST},
+    {{{0x03E0000000000000ULL}}, 5, 3, FIELD_DIR_EAST},
+    {{{0x07C0000000000000ULL}}, 5, 4, FIELD_DIR_EAST},
+    {{{0x0F80000000000000ULL}}, 5, 5, FIELD_DIR_EAST},
+    {{{0x0000010040100401ULL}}, 0, 0, FIELD_DIR_SOUTH},
+    {{{0x0000020080200802ULL}}, 0, 1, FIELD_DIR_SOUTH},
+    {{{0x0000040100401004ULL}}, 0, 2, FIELD_DIR_SOUTH},
+    {{{0x0000080200802008ULL}}, 0, 3, FIELD_DIR_SOUTH},
+    {{{0x0000100401004010ULL}}, 0, 4, FIELD_DIR_SOUTH},
+    {{{0x0000200802008020ULL}}, 0, 5, FIELD_DIR_SOUTH},
+    {{{0x0000401004010040ULL}}, 0, 6, FIELD_DIR_SOUTH},
+    {{{0x0000802008020080ULL}}, 0, 7, FIELD_DIR_SOUTH},
+    {{{0x0001004010040100ULL}}, 0, 8, FIELD_DIR_SOUTH},
+    {{{0x0002008020080200ULL}}, 0, 9, FIELD_DIR_SOUTH},
+    {{{0x0004010040100400ULL}}, 1, 0, FIELD_DIR_SOUTH},
+    {{{0x0008020080200800ULL}}, 1, 1, FIELD_DIR_SOUTH},
+    {{{0x0010040100401000ULL}}, 1, 2, FIELD_DIR_SOUTH},
+    {{{0x0020080200802000ULL}}, 1, 3, FIELD_DIR_SOUTH},
+    {{{0x0040100401004000ULL}}, 1, 4, FIELD_DIR_SOUTH},
+    {{{0x0080200802008000ULL}}, 1, 5, FIELD_DIR_SOUTH},
+    {{{0x0100401004010000ULL}}, 1, 6, FIELD_DIR_SOUTH},
+    {{{0x0200802008020000ULL}}, 1, 7, FIELD_DIR_SOUTH},
+    {{{0x0401004010040000ULL}}, 1, 8, FIELD_DIR_SOUTH},
+    {{{0x0802008020080000ULL}}, 1, 9, FIELD_DIR_SOUTH},
+    // FIELD_BOAT_TYPE_HUGE
+    {{{0x000000000000003FULL}}, 0, 0, FIELD_DIR_EAST},
+    {{{0x000000000000007EULL}}, 0, 1, FIELD_DIR_EAST},
+    {{{0x00000000000000FCULL}}, 0, 2, FIELD_DIR_EAST},
+    {{{0x00000000000001F8ULL}}, 0, 3, FIELD_DIR_EAST},
+    {{{0x00000000000003F0ULL}}, 0, 4, FIELD_DIR_EAST},
+    {{{0x000000000000FC00ULL}}, 1, 0, FIELD_DIR_EAST},
+    {{{0x000000000001F800ULL}}, 1, 1, FIELD_DIR_EAST},
+    {{{0x000000000003F000ULL}}, 1, 2, FIELD_DIR_EAST},
+    {{{0x000000000007E000ULL}}, 1, 3, FIELD_DIR_EAST},
+    {{{0x00000000000FC000ULL}}, 1, 4, FIELD_DIR_EAST},
+    {{{0x0000000003F00000ULL}}, 2, 0, FIELD_DIR_EAST},
+    {{{0x0000000007E00000ULL}}, 2, 1, FIELD_DIR_EAST},
+    {{{0x000000000FC00000ULL}}, 2, 2, FIELD_DIR_EAST},
+    {{{0x000000001F800000ULL}}, 2, 3, FIELD_DIR_EAST},
+    {{{0x000000003F000000ULL}}, 2, 4, FIELD_DIR_EAST},
+    {{{0x0000000FC0000000ULL}}, 3, 0, FIELD_DIR_EAST},
+    {{{0x0000001F80000000ULL}}, 3, 1, FIELD_DIR_EAST},
+    {{{0x0000003F00000000ULL}}, 3, 2, FIELD_DIR_EAST},
+    {{{0x0000007E00000000ULL}}, 3, 3, FIELD_DIR_EAST},
+    {{{0x000000FC00000000ULL}}, 3, 4, FIELD_DIR_EAST},
+    {{{0x00003F0000000000ULL}}, 4, 0, FIELD_DIR_EAST},
+    {{{0x00007E0000000000ULL}}, 4, 1, FIELD_DIR_EAST},
+    {{{0x0000FC0000000000ULL}}, 4, 2, FIELD_DIR_EAST},
+    {{{0x0001F80000000000ULL}}, 4, 3, FIELD_DIR_EAST},
+    {{{0x0003F00000000000ULL}}, 4, 4, FIELD_DIR_EAST},
+    {{{0x00FC000000000000ULL}}, 5, 0, FIELD_DIR_EAST},
+    {{{0x01F8000000000000ULL}}, 5, 1, FIELD_DIR_EAST},
+    {{{0x03F0000000000000ULL}}, 5, 2, FIELD_DIR_EAST},
+    {{{0x07E0000000000000ULL}}, 5, 3, FIELD_DIR_EAST},
+    {{{0x0FC0000000000000ULL}}, 5, 4, FIELD_DIR_EAST},
+    {{{0x0004010040100401ULL}}, 0, 0, FIELD_DIR_SOUTH},
+    {{{0x0008020080200802ULL}}, 0, 1, FIELD_DIR_SOUTH},
+    {{{0x0010040100401004ULL}}, 0, 2, FIELD_DIR_SOUTH},
+    {{{0x0020080200802008ULL}}, 0, 3, FIELD_DIR_SOUTH},
+    {{{0x0040100401004010ULL}}, 0, 4, FIELD_DIR_SOUTH},
+    {{{0x0080200802008020ULL}}, 0, 5, FIELD_DIR_SOUTH},
+    {{{0x0100401004010040ULL}}, 0, 6, FIELD_DIR_SOUTH},
+    {{{0x0200802008020080ULL}}, 0, 7, FIELD_DIR_SOUTH},
+    {{{0x0401004010040100ULL}}, 0, 8, FIELD_DIR_SOUTH},
+    {{{0x0802008020080200ULL}}, 0, 9, FIELD_DIR_SOUTH},
+};
+
+const uint16_t fieldSquarePlacementStart[FIELD_NUM_SQUARES + 1] = {
+    0, 8, 20, 36, 55, 76, 97, 116, 132, 144, 152, 163,
+    178, 197, 219, 243, 267, 289, 308, 323, 334, 347, 364, 385,
+    409, 435, 461, 485, 506, 523, 536, 549, 566, 587, 611, 637,
+    663, 687, 708, 725, 738, 749, 764, 783, 805, 829, 853, 875,
+    894, 909, 920, 928, 940, 956, 975, 996, 1017, 1036, 1052, 1064,
+    1072
+};
+
+const uint16_t fieldSquarePlacements[FIELD_NUM_PLACEMENT_SQUARES] = {
+    // Square 0
+    0, 48, 88, 130, 160, 196, 216, 246,
+    // Square 1
+    0, 1, 49, 88, 89, 131, 160, 161, 197, 216, 217, 247,
+    // Square 2
+    0, 1, 2, 50, 88, 89, 90, 132, 160, 161, 162, 198,
+    216, 217, 218, 248,
+    // Square 3
+    1, 2, 3, 51, 88, 89, 90, 91, 133, 160, 161, 162,
+    163, 199, 216, 217, 218, 219, 249,
+    // Square 4
+    2, 3, 4, 52, 89, 90, 91, 92, 134, 160, 161, 162,
+    163, 164, 200, 216, 217, 218, 219, 220, 250,
+    // Square 5
+    3, 4, 5, 53, 90, 91, 92, 93, 135, 161, 162, 163,
+    164, 165, 201, 216, 217, 218, 219, 220, 251,
+    // Square 6
+    4, 5, 6, 54, 91, 92, 93, 94, 136, 162, 163, 164,
+    165, 202, 217, 218, 219, 220, 252,
+    // Square 7
+    5, 6, 7, 55, 92, 93, 94, 137, 163, 164, 165, 203,
+    218, 219, 220, 253,
+    // Square 8
+    6, 7, 56, 93, 94, 138, 164, 165, 204, 219, 220, 254,
+    // Square 9
+    7, 57, 94, 139, 165, 205, 220, 255,
+    // Square 10
+    8, 48, 58, 95, 130, 140, 166, 196, 206, 221, 246,
+    // Square 11
+    8, 9, 49, 59, 95, 96, 131, 141, 166, 167, 197, 207,
+    221, 222, 247,
+    // Square 12
+    8, 9, 10, 50, 60, 95, 96, 97, 132, 142, 166, 167,
+    168, 198, 208, 221, 222, 223, 248,
+    // Square 13
+    9, 10, 11, 51, 61, 95, 96, 97, 98, 133, 143, 166,
+    167, 168, 169, 199, 209, 221, 222, 223, 224, 249,
+    // Square 14
+    10, 11, 12, 52, 62, 96, 97, 98, 99, 134, 144, 166,
+    167, 168, 169, 170, 200, 210, 221, 222, 223, 224, 225, 250,
+    // Square 15
+    11, 12, 13, 53, 63, 97, 98, 99, 100, 135, 145, 167,
+    168, 169, 170, 171, 201, 211, 221, 222, 223, 224, 225, 251,
+    // Square 16
+    12, 13, 14, 54, 64, 98, 99, 100, 101, 136, 146, 168,
+    169, 170, 171, 202, 212, 222, 223, 224, 225, 252,
+    // Square 17
+    13, 14, 15, 55, 65, 99, 100, 101, 137, 147, 169, 170,
+    171, 203, 213, 223, 224, 225, 253,
+    // Square 18
+    14, 15, 56, 66, 100, 101, 138, 148, 170, 171, 204, 214,
+    224, 225, 254,
+    // Square 19
+    15, 57, 67, 101, 139, 149, 171, 205, 215, 225, 255,
+    // Square 20
+    16, 48, 58, 68, 102, 130, 140, 150, 172, 196, 206, 226,
+    246,
+    // Square 21
+    16, 17, 49, 59, 69, 102, 103, 131, 141, 151, 172, 173,
+    197, 207, 226, 227, 247,
+    // Square 22
+    16, 17, 18, 50, 60, 70, 102, 103, 104, 132, 142, 152,
+    172, 173, 174, 198, 208, 226, 227, 228, 248,
+    // Square 23
+    17, 18, 19, 51, 61, 71, 102, 103, 104, 105, 133, 143,
+    153, 172, 173, 174, 175, 199, 209, 226, 227, 228, 229, 249,
+    // Square 24
+    18, 19, 20, 52, 62, 72, 103, 104, 105, 106, 134, 144,
+    154, 172, 173, 174, 175, 176, 200, 210, 226, 227, 228, 229,
+    230, 250,
+    // Square 25
+    19, 20, 21, 53, 63, 73, 104, 105, 106, 107, 135, 145,
+    155, 173, 174, 175, 176, 177, 201, 211, 226, 227, 228, 229,
+    230, 251,
+    // Square 26
+    20, 21, 22, 54, 64, 74, 105, 106, 107, 108, 136, 146,
+    156, 174, 175, 176, 177, 202, 212, 227, 228, 229, 230, 252,
+    // Square 27
+    21, 22, 23, 55, 65, 75, 106, 107, 108, 137, 147, 157,
+    175, 176, 177, 203, 213, 228, 229, 230, 253,
+    // Square 28
+    22, 23, 56, 66, 76, 107, 108, 138, 148, 158, 176, 177,
+    204, 214, 229, 230, 254,
+    // Square 29
+    23, 57, 67, 77, 108, 139, 149, 159, 177, 205, 215, 230,
+    255,
+    // Square 30
+    24, 58, 68, 78, 109, 130, 140, 150, 178, 196, 206, 231,
+    246,
+    // Square 31
+    24, 25, 59, 69, 79, 109, 110, 131, 141, 151, 178, 179,
+    197, 207, 231, 232, 247,
+    // Square 32
+    24, 25, 26, 60, 70, 80, 109, 110, 111, 132, 142, 152,
+    178, 179, 180, 198, 208, 231, 232, 233, 248,
+    // Square 33
+    25, 26, 27, 61, 71, 81, 109, 110, 111, 112, 133, 143,
+    153, 178, 179, 180, 181, 199, 209, 231, 232, 233, 234, 249,
+    // Square 34
+    26, 27, 28, 62, 72, 82, 110, 111, 112, 113, 134, 144,
+    154, 178, 179, 180, 181, 182, 200, 210, 231, 232, 233, 234,
+    235, 250,
+    // Square 35
+    27, 28, 29, 63, 73, 83, 111, 112, 113, 114, 135, 145,
+    155, 179, 180, 181, 182, 183, 201, 211, 231, 232, 233, 234,
+    235, 251,
+    // Square 36
+    28, 29, 30, 64, 74, 84, 112, 113, 114, 115, 136, 146,
+    156, 180, 181, 182, 183, 202, 212, 232, 233, 234, 235, 252,
+    // Square 37
+    29, 30, 31, 65, 75, 85, 113, 114, 115, 137, 147, 157,
+    181, 182, 183, 203, 213, 233, 234, 235, 253,
+    // Square 38
+    30, 31, 66, 76, 86, 114, 115, 138, 148, 158, 182, 183,
+    204, 214, 234, 235, 254,
+    // Square 39
+    31, 67, 77, 87, 115, 139, 149, 159, 183, 205, 215, 235,
+    255,
+    // Square 40
+    32, 68, 78, 116, 140, 150, 184, 196, 206, 236, 246,
+    // Square 41
+    32, 33, 69, 79, 116, 117, 141, 151, 184, 185, 197, 207,
+    236, 237, 247,
+    // Square 42
+    32, 33, 34, 70, 80, 116, 117, 118, 142, 152, 184, 185,
+    186, 198, 208, 236, 237, 238, 248,
+    // Square 43
+    33, 34, 35, 71, 81, 116, 117, 118, 119, 143, 153, 184,
+    185, 186, 187, 199, 209, 236, 237, 238, 239, 249,
+    // Square 44
+    34, 35, 36, 72, 82, 117, 118, 119, 120, 144, 154, 184,
+    185, 186, 187, 188, 200, 210, 236, 237, 238, 239, 240, 250,
+    // Square 45
+    35, 36, 37, 73, 83, 118, 119, 120, 121, 145, 155, 185,
+    186, 187, 188, 189, 201, 211, 236, 237, 238, 239, 240, 251,
+    // Square 46
+    36, 37, 38, 74, 84, 119, 120, 121, 122, 146, 156, 186,
+    187, 188, 189, 202, 212, 237, 238, 239, 240, 252,
+    // Square 47
+    37, 38, 39, 75, 85, 120, 121, 122, 147, 157, 187, 188,
+    189, 203, 213, 238, 239, 240, 253,
+    // Square 48
+    38, 39, 76, 86, 121, 122, 148, 158, 188, 189, 204, 214,
+    239, 240, 254,
+    // Square 49
+    39, 77, 87, 122, 149, 159, 189, 205, 215, 240, 255,
+    // Square 50
+    40, 78, 123, 150, 190, 206, 241, 246,
+    // Square 51
+    40, 41, 79, 123, 124, 151, 190, 191, 207, 241, 242, 247,
+    // Square 52
+    40, 41, 42, 80, 123, 124, 125, 152, 190, 191, 192, 208,
+    241, 242, 243, 248,
+    // Square 53
+    41, 42, 43, 81, 123, 124, 125, 126, 153, 190, 191, 192,
+    193, 209, 241, 242, 243, 244, 249,
+    // Square 54
+    42, 43, 44, 82, 124, 125, 126, 127, 154, 190, 191, 192,
+    193, 194, 210, 241, 242, 243, 244, 245, 250,
+    // Square 55
+    43, 44, 45, 83, 125, 126, 127, 128, 155, 191, 192, 193,
+    194, 195, 211, 241, 242, 243, 244, 245, 251,
+    // Square 56
+    44, 45, 46, 84, 126, 127, 128, 129, 156, 192, 193, 194,
+    195, 212, 242, 243, 244, 245, 252,
+    // Square 57
+    45, 46, 47, 85, 127, 128, 129, 157, 193, 194, 195, 213,
+    243, 244, 245, 253,
+    // Square 58
+    46, 47, 86, 128, 129, 158, 194, 195, 214, 244, 245, 254,
+    // Square 59
+    47, 87, 129, 159, 195, 215, 245, 255,
+};
+
+const uint32_t fieldFleetTotal = 3037764UL;
+
+const uint32_t fieldFleetCountHuge[FIELD_NUM_HUGE_PLACEMENTS] = {
+    98168, 96105, 95072, 96105, 98168, 74000, 74737, 74766,
+    74737, 74000, 63075, 64793, 65194, 64793, 63075, 63075,
+    64793, 65194, 64793, 63075, 74000, 74737, 74766, 74737,
+    74000, 98168, 96105, 95072, 96105, 98168, 116234, 84152,
+    59654, 45056, 36998, 36998, 45056, 59654, 84152, 116234
+};
+
+const uint32_t fieldFleetCountHugeLarge[FIELD_NUM_HUGE_PLACEMENTS][FIELD_NUM_LARGE_PLACEMENTS] = {
+    {0, 0, 0, 0, 0, 0, 2686, 2599, 2416, 2328, 2327, 2315,
+     2240, 2182, 2033, 1955, 1940, 1909, 2060, 2014, 1916, 1879, 1894, 1892,
+     2236, 2173, 2104, 2108, 2185, 2252, 2682, 2590, 2495, 2497, 2596, 2690,
+     0, 0, 0, 0, 0, 0, 1946, 2088, 2423, 2834, 2933, 2443,
+     2003, 1781, 1808, 1820, 1730, 1954, 2374, 2838},
+    {0, 0, 0, 0, 0, 0, 2487, 2504, 2414, 2323, 2319, 2306,
+     2061, 2097, 2031, 1950, 1932, 1900, 1934, 1936, 1880, 1842, 1856, 1854,
+     2156, 2091, 2020, 2024, 2099, 2164, 2590, 2498, 2403, 2405, 2502, 2594,
+     2834, 0, 0, 0, 0, 0, 0, 2088, 2428, 2795, 2727, 2359,
+     1929, 1707, 1727, 1734, 1726, 1863, 2278, 2738},
+    {0, 0, 0, 0, 0, 0, 2352, 2367, 2374, 2374, 2367, 2352,
+     1941, 1975, 1996, 1996, 1975, 1941, 1857, 1859, 1846, 1846, 1859, 1857,
+     2124, 2060, 1986, 1986, 2060, 2124, 2551, 2460, 2364, 2364, 2460, 2551,
+     2795, 2423, 0, 0, 0, 0, 0, 0, 2423, 2795, 2689, 2229,
+     1905, 1685, 1698, 1698, 1685, 1905, 2229, 2689},
+    {0, 0, 0, 0, 0, 0, 2306, 2319, 2323, 2414, 2504, 2487,
+     1900, 1932, 1950, 2031, 2097, 2061, 1854, 1856, 1842, 1880, 1936, 1934,
+     2164, 2099, 2024, 2020, 2091, 2156, 2594, 2502, 2405, 2403, 2498, 2590,
+     2795, 2428, 2088, 0, 0, 0, 0, 0, 0, 2834, 2738, 2278,
+     1863, 1726, 1734, 1727, 1707, 1929, 2359, 2727},
+    {0, 0, 0, 0, 0, 0, 2315, 2327, 2328, 2416, 2599, 2686,
+     1909, 1940, 1955, 2033, 2182, 2240, 1892, 1894, 1879, 1916, 2014, 2060,
+     2252, 2185, 2108, 2104, 2173, 2236, 2690, 2596, 2497, 2495, 2590, 2682,
+     2834, 2423, 2088, 1946, 0, 0, 0, 0, 0, 0, 2838, 2374,
+     1954, 1730, 1820, 1808, 1781, 2003, 2443, 2933},
+    {2599, 2495, 2302, 2216, 2229, 2236, 0, 0, 0, 0, 0, 0,
+     2167, 2097, 1864, 1716, 1637, 1545, 1992, 1934, 1755, 1649, 1599, 1533,
+     1988, 1925, 1818, 1784, 1814, 1832, 2159, 2079, 1998, 2002, 2091, 2175,
+     0, 0, 0, 0, 0, 0, 1496, 1639, 1940, 2303, 0, 0,
+     0, 0, 0, 0, 1505, 1643, 1941, 2303},
+    {2423, 2421, 2319, 2230, 2240, 2246, 0, 0, 0, 0, 0, 0,
+     1918, 2030, 1957, 1799, 1712, 1616, 1799, 1874, 1811, 1699, 1645, 1578,
+     1886, 1868, 1800, 1765, 1794, 1812, 2100, 2018, 1935, 1939, 2026, 2108,
+     2303, 0, 0, 0, 0, 0, 0, 1639, 1950, 2283, 2308, 0,
+     0, 0, 0, 0, 0, 1648, 1954, 2284},
+    {2299, 2295, 2288, 2288, 2295, 2299, 0, 0, 0, 0, 0, 0,
+     1731, 1834, 1930, 1930, 1834, 1731, 1656, 1726, 1785, 1785, 1726, 1656,
+     1821, 1803, 1775, 1775, 1803, 1821, 2077, 1996, 1910, 1910, 1996, 2077,
+     2283, 1940, 0, 0, 0, 0, 0, 0, 1940, 2283, 2286, 1948,
+     0, 0, 0, 0, 0, 0, 1948, 2286},
+    {2246, 2240, 2230, 2319, 2421, 2423, 0, 0, 0, 0, 0, 0,
+     1616, 1712, 1799, 1957, 2030, 1918, 1578, 1645, 1699, 1811, 1874, 1799,
+     1812, 1794, 1765, 1800, 1868, 1886, 2108, 2026, 1939, 1935, 2018, 2100,
+     2283, 1950, 1639, 0, 0, 0, 0, 0, 0, 2303, 2284, 1954,
+     1648, 0, 0, 0, 0, 0, 0, 2308},
+    {2236, 2229, 2216, 2302, 2495, 2599, 0, 0, 0, 0, 0, 0,
+     1545, 1637, 1716, 1864, 2097, 2167, 1533, 1599, 1649, 1755, 1934, 1992,
+     1832, 1814, 1784, 1818, 1925, 1988, 2175, 2091, 2002, 1998, 2079, 2159,
+     2303, 1940, 1639, 1496, 0, 0, 0, 0, 0, 0, 2303, 1941,
+     1643, 1505, 0, 0, 0, 0, 0, 0},
+    {2086, 1994, 1825, 1751, 1764, 1771, 2090, 2003, 1762, 1618, 1555, 1484,
+     0, 0, 0, 0, 0, 0, 1924, 1854, 1598, 1431, 1328, 1214,
+     1920, 1845, 1657, 1554, 1519, 1473, 1916, 1836, 1716, 1681, 1722, 1756,
+     0, 0, 0, 0, 0, 0, 1109, 1251, 1517, 1832, 0, 0,
+     0, 0, 0, 0, 1115, 1254, 1518, 1832},
+    {1953, 1951, 1861, 1784, 1794, 1800, 1866, 1957, 1872, 1718, 1647, 1572,
+     0, 0, 0, 0, 0, 0, 1668, 1812, 1742, 1560, 1446, 1326,
+     1751, 1806, 1731, 1622, 1583, 1536, 1834, 1800, 1720, 1684, 1724, 1758,
+     1834, 0, 0, 0, 0, 0, 0, 1253, 1533, 1831, 1837, 0,
+     0, 0, 0, 0, 0, 1259, 1536, 1832},
+    {1855, 1851, 1844, 1844, 1851, 1855, 1692, 1774, 1854, 1854, 1774, 1692,
+     0, 0, 0, 0, 0, 0, 1467, 1597, 1724, 1724, 1597, 1467,
+     1620, 1670, 1714, 1714, 1670, 1620, 1777, 1743, 1704, 1704, 1743, 1777,
+     1832, 1520, 0, 0, 0, 0, 0, 0, 1520, 1832, 1834, 1525,
+     0, 0, 0, 0, 0, 0, 1525, 1834},
+    {1800, 1794, 1784, 1861, 1951, 1953, 1572, 1647, 1718, 1872, 1957, 1866,
+     0, 0, 0, 0, 0, 0, 1326, 1446, 1560, 1742, 1812, 1668,
+     1536, 1583, 1622, 1731, 1806, 1751, 1758, 1724, 1684, 1720, 1800, 1834,
+     1831, 1533, 1253, 0, 0, 0, 0, 0, 0, 1834, 1832, 1536,
+     1259, 0, 0, 0, 0, 0, 0, 1837},
+    {1771, 1764, 1751, 1825, 1994, 2086, 1484, 1555, 1618, 1762, 2003, 2090,
+     0, 0, 0, 0, 0, 0, 1214, 1328, 1431, 1598, 1854, 1924,
+     1473, 1519, 1554, 1657, 1845, 1920, 1756, 1722, 1681, 1716, 1836, 1916,
+     1832, 1517, 1251, 1109, 0, 0, 0, 0, 0, 0, 1832, 1518,
+     1254, 1115, 0, 0, 0, 0, 0, 0},
+    {1916, 1836, 1716, 1681, 1722, 1756, 1920, 1845, 1657, 1554, 1519, 1473,
+     1924, 1854, 1598, 1431, 1328, 1214, 0, 0, 0, 0, 0, 0,
+     2090, 2003, 1762, 1618, 1555, 1484, 2086, 1994, 1825, 1751, 1764, 1771,
+     0, 0, 0, 0, 0, 0, 1115, 1254, 1518, 1832, 0, 0,
+     0, 0, 0, 0, 1109, 1251, 1517, 1832},
+    {1834, 1800, 1720, 1684, 1724, 1758, 1751, 1806, 1731, 1622, 1583, 1536,
+     1668, 1812, 1742, 1560, 1446, 1326, 0, 0, 0, 0, 0, 0,
+     1866, 1957, 1872, 1718, 1647, 1572, 1953, 1951, 1861, 1784, 1794, 1800,
+     1837, 0, 0, 0, 0, 0, 0, 1259, 1536, 1832, 1834, 0,
+     0, 0, 0, 0, 0, 1253, 1533, 1831},
+    {1777, 1743, 1704, 1704, 1743, 1777, 1620, 1670, 1714, 1714, 1670, 1620,
+     1467, 1597, 1724, 1724, 1597, 1467, 0, 0, 0, 0, 0, 0,
+     1692, 1774, 1854, 1854, 1774, 1692, 1855, 1851, 1844, 1844, 1851, 1855,
+     1834, 1525, 0, 0, 0, 0, 0, 0, 1525, 1834, 1832, 1520,
+     0, 0, 0, 0, 0, 0, 1520, 1832},
+    {1758, 1724, 1684, 1720, 1800, 1834, 1536, 1583, 1622, 1731, 1806, 1751,
+     1326, 1446, 1560, 1742, 1812, 1668, 0, 0, 0, 0, 0, 0,
+     1572, 1647, 1718, 1872, 1957, 1866, 1800, 1794, 1784, 1861, 1951, 1953,
+     1832, 1536, 1259, 0, 0, 0, 0, 0, 0, 1837, 1831, 1533,
+     1253, 0, 0, 0, 0, 0, 0, 1834},
+    {1756, 1722, 1681, 1716, 1836, 1916, 1473, 1519, 1554, 1657, 1845, 1920,
+     1214, 1328, 1431, 1598, 1854, 1924, 0, 0, 0, 0, 0, 0,
+     1484, 1555, 1618, 1762, 2003, 2090, 1771, 1764, 1751, 1825, 1994, 2086,
+     1832, 1518, 1254, 1115, 0, 0, 0, 0, 0, 0, 1832, 1517,
+     1251, 1109, 0, 0, 0, 0, 0, 0},
+    {2159, 2079, 1998, 2002, 2091, 2175, 1988, 1925, 1818, 1784, 1814, 1832,
+     1992, 1934, 1755, 1649, 1599, 1533, 2167, 2097, 1864, 1716, 1637, 1545,
+     0, 0, 0, 0, 0, 0, 2599, 2495, 2302, 2216, 2229, 2236,
+     0, 0, 0, 0, 0, 0, 1505, 1643, 1941, 2303, 0, 0,
+     0, 0, 0, 0, 1496, 1639, 1940, 2303},
+    {2100, 2018, 1935, 1939, 2026, 2108, 1886, 1868, 1800, 1765, 1794, 1812,
+     1799, 1874, 1811, 1699, 1645, 1578, 1918, 2030, 1957, 1799, 1712, 1616,
+     0, 0, 0, 0, 0, 0, 2423, 2421, 2319, 2230, 2240, 2246,
+     2308, 0, 0, 0, 0, 0, 0, 1648, 1954, 2284, 2303, 0,
+     0, 0, 0, 0, 0, 1639, 1950, 2283},
+    {2077, 1996, 1910, 1910, 1996, 2077, 1821, 1803, 1775, 1775, 1803, 1821,
+     1656, 1726, 1785, 1785, 1726, 1656, 1731, 1834, 1930, 1930, 1834, 1731,
+     0, 0, 0, 0, 0, 0, 2299, 2295, 2288, 2288, 2295, 2299,
+     2286, 1948, 0, 0, 0, 0, 0, 0, 1948, 2286, 2283, 1940,
+     0, 0, 0, 0, 0, 0, 1940, 2283},
+    {2108, 2026, 1939, 1935, 2018, 2100, 1812, 1794, 1765, 1800, 1868, 1886,
+     1578, 1645, 1699, 1811, 1874, 1799, 1616, 1712, 1799, 1957, 2030, 1918,
+     0, 0, 0, 0, 0, 0, 2246, 2240, 2230, 2319, 2421, 2423,
+     2284, 1954, 1648, 0, 0, 0, 0, 0, 0, 2308, 2283, 1950,
+     1639, 0, 0, 0, 0, 0, 0, 2303},
+    {2175, 2091, 2002, 1998, 2079, 2159, 1832, 1814, 1784, 1818, 1925, 1988,
+     1533, 1599, 1649, 1755, 1934, 1992, 1545, 1637, 1716, 1864, 2097, 2167,
+     0, 0, 0, 0, 0, 0, 2236, 2229, 2216, 2302, 2495, 2599,
+     2303, 1941, 1643, 1505, 0, 0, 0, 0, 0, 0, 2303, 1940,
+     1639, 1496, 0, 0, 0, 0, 0, 0},
+    {2682, 2590, 2495, 2497, 2596, 2690, 2236, 2173, 2104, 2108, 2185, 2252,
+     2060, 2014, 1916, 1879, 1894, 1892, 2240, 2182, 2033, 1955, 1940, 1909,
+     2686, 2599, 2416, 2328, 2327, 2315, 0, 0, 0, 0, 0, 0,
+     2933, 2443, 2003, 1781, 1808, 1820, 1730, 1954, 2374, 2838, 0, 0,
+     0, 0, 0, 0, 1946, 2088, 2423, 2834},
+    {2590, 2498, 2403, 2405, 2502, 2594, 2156, 2091, 2020, 2024, 2099, 2164,
+     1934, 1936, 1880, 1842, 1856, 1854, 2061, 2097, 2031, 1950, 1932, 1900,
+     2487, 2504, 2414, 2323, 2319, 2306, 0, 0, 0, 0, 0, 0,
+     2727, 2359, 1929, 1707, 1727, 1734, 1726, 1863, 2278, 2738, 2834, 0,
+     0, 0, 0, 0, 0, 2088, 2428, 2795},
+    {2551, 2460, 2364, 2364, 2460, 2551, 2124, 2060, 1986, 1986, 2060, 2124,
+     1857, 1859, 1846, 1846, 1859, 1857, 1941, 1975, 1996, 1996, 1975, 1941,
+     2352, 2367, 2374, 2374, 2367, 2352, 0, 0, 0, 0, 0, 0,
+     2689, 2229, 1905, 1685, 1698, 1698, 1685, 1905, 2229, 2689, 2795, 2423,
+     0, 0, 0, 0, 0, 0, 2423, 2795},
+    {2594, 2502, 2405, 2403, 2498, 2590, 2164, 2099, 2024, 2020, 2091, 2156,
+     1854, 1856, 1842, 1880, 1936, 1934, 1900, 1932, 1950, 2031, 2097, 2061,
+     2306, 2319, 2323, 2414, 2504, 2487, 0, 0, 0, 0, 0, 0,
+     2738, 2278, 1863, 1726, 1734, 1727, 1707, 1929, 2359, 2727, 2795, 2428,
+     2088, 0, 0, 0, 0, 0, 0, 2834},
+    {2690, 2596, 2497, 2495, 2590, 2682, 2252, 2185, 2108, 2104, 2173, 2236,
+     1892, 1894, 1879, 1916, 2014, 2060, 1909, 1940, 1955, 2033, 2182, 2240,
+     2315, 2327, 2328, 2416, 2599, 2686, 0, 0, 0, 0, 0, 0,
+     2838, 2374, 1954, 1730, 1820, 1808, 1781, 2003, 2443, 2933, 2834, 2423,
+     2088, 1946, 0, 0, 0, 0, 0, 0},
+    {0, 2933, 2834, 2790, 2834, 2933, 0, 2472, 2402, 2371, 2402, 2472,
+     0, 2051, 2010, 1992, 2010, 2051, 0, 2051, 2010, 1992, 2010, 2051,
+     0, 2472, 2402, 2371, 2402, 2472, 0, 2933, 2834, 2790, 2834, 2933,
+     0, 3088, 2602, 2166, 1946, 1956, 1946, 2166, 2602, 3088, 0, 3088,
+     2602, 2166, 1946, 1956, 1946, 2166, 2602, 3088},
+    {0, 0, 2359, 2325, 2325, 2359, 0, 0, 1958, 1942, 1942, 1958,
+     0, 0, 1597, 1599, 1599, 1597, 0, 0, 1597, 1599, 1599, 1597,
+     0, 0, 1958, 1942, 1942, 1958, 0, 0, 2359, 2325, 2325, 2359,
+     2976, 0, 2500, 2074, 1698, 1498, 1498, 1698, 2074, 2500, 2976, 0,
+     2500, 2074, 1698, 1498, 1498, 1698, 2074, 2500},
+    {0, 0, 0, 1905, 1910, 1905, 0, 0, 0, 1553, 1563, 1553,
+     0, 0, 0, 1241, 1256, 1241, 0, 0, 0, 1241, 1256, 1241,
+     0, 0, 0, 1553, 1563, 1553, 0, 0, 0, 1905, 1910, 1905,
+     2400, 2400, 0, 1984, 1618, 1292, 1112, 1292, 1618, 1984, 2400, 2400,
+     0, 1984, 1618, 1292, 1112, 1292, 1618, 1984},
+    {0, 0, 0, 0, 1726, 1726, 0, 0, 0, 0, 1380, 1380,
+     0, 0, 0, 0, 1074, 1074, 0, 0, 0, 0, 1074, 1074,
+     0, 0, 0, 0, 1380, 1380, 0, 0, 0, 0, 1726, 1726,
+     1936, 1936, 1936, 0, 1726, 1380, 1074, 1074, 1380, 1726, 1936, 1936,
+     1936, 0, 1726, 1380, 1074, 1074, 1380, 1726},
+    {0, 0, 0, 0, 0, 1820, 0, 0, 0, 0, 0, 1445,
+     0, 0, 0, 0, 0, 1110, 0, 0, 0, 0, 0, 1110,
+     0, 0, 0, 0, 0, 1445, 0, 0, 0, 0, 0, 1820,
+     1730, 1579, 1579, 1730, 0, 1740, 1384, 1258, 1384, 1740, 1730, 1579,
+     1579, 1730, 0, 1740, 1384, 1258, 1384, 1740},
+    {1820, 0, 0, 0, 0, 0, 1445, 0, 0, 0, 0, 0,
+     1110, 0, 0, 0, 0, 0, 1110, 0, 0, 0, 0, 0,
+     1445, 0, 0, 0, 0, 0, 1820, 0, 0, 0, 0, 0,
+     1740, 1384, 1258, 1384, 1740, 0, 1730, 1579, 1579, 1730, 1740, 1384,
+     1258, 1384, 1740, 0, 1730, 1579, 1579, 1730},
+    {1726, 1726, 0, 0, 0, 0, 1380, 1380, 0, 0, 0, 0,
+     1074, 1074, 0, 0, 0, 0, 1074, 1074, 0, 0, 0, 0,
+     1380, 1380, 0, 0, 0, 0, 1726, 1726, 0, 0, 0, 0,
+     1726, 1380, 1074, 1074, 1380, 1726, 0, 1936, 1936, 1936, 1726, 1380,
+     1074, 1074, 1380, 1726, 0, 1936, 1936, 1936},
+    {1905, 1910, 1905, 0, 0, 0, 1553, 1563, 1553, 0, 0, 0,
+     1241, 1256, 1241, 0, 0, 0, 1241, 1256, 1241, 0, 0, 0,
+     1553, 1563, 1553, 0, 0, 0, 1905, 1910, 1905, 0, 0, 0,
+     1984, 1618, 1292, 1112, 1292, 1618, 1984, 0, 2400, 2400, 1984, 1618,
+     1292, 1112, 1292, 1618, 1984, 0, 2400, 2400},
+    {2359, 2325, 2325, 2359, 0, 0, 1958, 1942, 1942, 1958, 0, 0,
+     1597, 1599, 1599, 1597, 0, 0, 1597, 1599, 1599, 1597, 0, 0,
+     1958, 1942, 1942, 1958, 0, 0, 2359, 2325, 2325, 2359, 0, 0,
+     2500, 2074, 1698, 1498, 1498, 1698, 2074, 2500, 0, 2976, 2500, 2074,
+     1698, 1498, 1498, 1698, 2074, 2500, 0, 2976},
+    {2933, 2834, 2790, 2834, 2933, 0, 2472, 2402, 2371, 2402, 2472, 0,
+     2051, 2010, 1992, 2010, 2051, 0, 2051, 2010, 1992, 2010, 2051, 0,
+     2472, 2402, 2371, 2402, 2472, 0, 2933, 2834, 2790, 2834, 2933, 0,
+     3088, 2602, 2166, 1946, 1956, 1946, 2166, 2602, 3088, 0, 3088, 2602,
+     2166, 1946, 1956, 1946, 2166, 2602, 3088, 0},
+};
@@ -6,13 +6,18 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "Field.h"
 #include "Uart1.h"
 #include "BOARD.h"
 #include "FieldOled.h"
+#include "FieldDensity.h"
+#include "FieldMonteCarlo.h"
 static Field testOwnField;
 static Field testOppField;
 static GuessData gData;
+static FieldDensity testDensity;
+static uint32_t testDensityFull[FIELD_NUM_SQUARES];
 static uint8_t testCol = 4;
 static uint8_t testRow = 5;
 /*
@@ -61,7 +66,7 @@ int main() {
     if(resCount == 2) {
         printf("PASSED: 2/2 TESTS PASSED\n");
     } else {
-        printf("FAILED: %d/2 TESTS PASSED\n");
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
     }
     resCount = 0;
     FieldInit(&testOwnField, &testOppField);
@@ -86,16 +91,205 @@ int main() {
     if (resCount == 4) {
         printf("PASSED: 4/4 TESTS PASSED\n");
     } else {
-        printf("FAILED: %d/4 TESTS PASSED\n");
+        printf("FAILED: %d/4 TESTS PASSED\n", resCount);
     }
     resCount = 0;
     printf("Now Testing FieldRegisterEnemyAttack()\n");
-    gData.col = 0
+    gData.col = 0;
     gData.row = 0;        
+    if (FieldRegisterEnemyAttack(&testOwnField, &gData) == FIELD_SQUARE_SMALL_BOAT &&
+            gData.result == RESULT_HIT) {
+        resCount++;
+    }
+    gData.col = 1;
     FieldRegisterEnemyAttack(&testOwnField, &gData);
-    
+    gData.col = 2;
+    FieldRegisterEnemyAttack(&testOwnField, &gData);
+    if (gData.result == RESULT_SMALL_BOAT_SUNK) {
+        resCount++;
+    }
+    if (FieldGetBoatStates(&testOwnField) == (FIELD_BOAT_STATUS_LARGE | FIELD_BOAT_STATUS_HUGE)) {
+        resCount++;
+    }
+    gData.row = testRow;
+    gData.col = testCol;
+    if (FieldRegisterEnemyAttack(&testOwnField, &gData) == FIELD_SQUARE_EMPTY &&
+            gData.result == RESULT_MISS &&
+            FieldGetSquareStatus(&testOwnField, testRow, testCol) == FIELD_SQUARE_MISS) {
+        resCount++;
+    }
+    if (resCount == 4) {
+        printf("PASSED: 4/4 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/4 TESTS PASSED\n", resCount);
+    }
+    resCount = 0;
+    printf("Now Testing FieldUpdateKnowledge()\n");
+    gData.row = 2;
+    gData.col = 3;
+    gData.result = RESULT_HIT;
+    if (FieldUpdateKnowledge(&testOppField, &gData) == FIELD_SQUARE_UNKNOWN &&
+            FieldGetSquareStatus(&testOppField, 2, 3) == FIELD_SQUARE_HIT) {
+        resCount++;
+    }
+    gData.col = 4;
+    gData.result = RESULT_MISS;
+    FieldUpdateKnowledge(&testOppField, &gData);
+    if (FieldGetSquareStatus(&testOppField, 2, 4) == FIELD_SQUARE_EMPTY) {
+        resCount++;
+    }
+    gData.col = 5;
+    gData.result = RESULT_MEDIUM_BOAT_SUNK;
+    FieldUpdateKnowledge(&testOppField, &gData);
+    if (FieldGetBoatStates(&testOppField) ==
+            (FIELD_BOAT_STATUS_SMALL | FIELD_BOAT_STATUS_LARGE | FIELD_BOAT_STATUS_HUGE)) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing FieldAIPlaceAllBoats()\n");
+    int trial;
+    for (trial = 0; trial < 100; trial++) {
+        int boatSquares = 0;
+        int i, j;
+        FieldInit(&testOwnField, &testOppField);
+        if (FieldAIPlaceAllBoats(&testOwnField) != SUCCESS) {
+            break;
+        }
+        for (i = 0; i < FIELD_ROWS; i++) {
+            for (j = 0; j < FIELD_COLS; j++) {
+                SquareStatus status = FieldGetSquareStatus(&testOwnField, i, j);
+                if (status >= FIELD_SQUARE_SMALL_BOAT && status <= FIELD_SQUARE_HUGE_BOAT) {
+                    boatSquares++;
+                }
+            }
+        }
+        if (boatSquares == FIELD_BOAT_SIZE_SMALL + FIELD_BOAT_SIZE_MEDIUM +
+                FIELD_BOAT_SIZE_LARGE + FIELD_BOAT_SIZE_HUGE &&
+                FieldGetBoatStates(&testOwnField) == 0x0F) {
+            resCount++;
+        }
+    }
+    if (FieldAIPlaceAllBoats(&testOwnField) == STANDARD_ERROR) {
+        resCount++; // The field is no longer empty.
+    }
+    if (resCount == 101) {
+        printf("PASSED: 101/101 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/101 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing FieldAIDecideGuess()\n");
+    int shots = 0;
+    for (trial = 0; trial < 100; trial++) {
+        int gameShots = 0;
+        int guessesValid = TRUE;
+        FieldInit(&testOwnField, &testOppField);
+        FieldAIPlaceAllBoats(&testOwnField);
+        while (FieldGetBoatStates(&testOwnField) && gameShots < FIELD_ROWS * FIELD_COLS) {
+            gData = FieldAIDecideGuess(&testOppField);
+            if (FieldGetSquareStatus(&testOppField, gData.row, gData.col) != FIELD_SQUARE_UNKNOWN) {
+                guessesValid = FALSE;
+            }
+            FieldRegisterEnemyAttack(&testOwnField, &gData);
+            FieldUpdateKnowledge(&testOppField, &gData);
+            gameShots++;
+        }
+        if (guessesValid && FieldGetBoatStates(&testOwnField) == 0 &&
+                FieldGetBoatStates(&testOppField) == 0) {
+            resCount++;
+        }
+        shots += gameShots;
+    }
+    // A random hunter needs around 57 shots per game on average.
+    if (shots < 100 * 45) {
+        resCount++;
+    }
+    if (resCount == 101) {
+        printf("PASSED: 101/101 TESTS PASSED (%d.%02d shots per game)\n", shots / 100, shots % 100);
+    } else {
+        printf("FAILED: %d/101 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing FieldDensityUpdate()\n");
+    for (trial = 0; trial < 50; trial++) {
+        int matches = TRUE;
+        FieldInit(&testOwnField, &testOppField);
+        FieldAIPlaceAllBoats(&testOwnField);
+        FieldDensityInit(&testDensity, &testOppField);
+        while (FieldGetBoatStates(&testOwnField)) {
+            gData = FieldDensityDecideGuess(&testDensity, &testOppField, &randomDefault);
+            FieldRegisterEnemyAttack(&testOwnField, &gData);
+            FieldUpdateKnowledge(&testOppField, &gData);
+            FieldDensityUpdate(&testDensity, &testOppField, &gData);
+            FieldAIComputeDensity(&testOppField, testDensityFull);
+            if (memcmp(testDensity.density, testDensityFull, sizeof (testDensityFull)) != 0) {
+                matches = FALSE;
+                break;
+            }
+        }
+        if (matches) {
+            resCount++;
+        }
+    }
+    if (resCount == 50) {
+        printf("PASSED: 50/50 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/50 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing FieldAIDecideGuessWithin()\n");
+    uint32_t budget = 2 * BOARD_CORE_TICKS_PER_MS;
+    int late = 0;
+    uint32_t samples = 0;
+    shots = 0;
+    for (trial = 0; trial < 20; trial++) {
+        int guessesValid = TRUE;
+        FieldInit(&testOwnField, &testOppField);
+        FieldAIPlaceAllBoats(&testOwnField);
+        while (FieldGetBoatStates(&testOwnField) && shots < 20 * FIELD_ROWS * FIELD_COLS) {
+            uint32_t drawn;
+            uint32_t start = BOARD_GetCoreTimer();
+            gData = FieldAIDecideGuessWithin(&testOppField, &randomDefault, budget, &drawn);
+            if (BOARD_GetCoreTimer() - start > budget + BOARD_CORE_TICKS_PER_MS) {
+                late++;
+            }
+            if (FieldGetSquareStatus(&testOppField, gData.row, gData.col) != FIELD_SQUARE_UNKNOWN) {
+                guessesValid = FALSE;
+            }
+            FieldRegisterEnemyAttack(&testOwnField, &gData);
+            FieldUpdateKnowledge(&testOppField, &gData);
+            samples += drawn;
+            shots++;
+        }
+        if (guessesValid && FieldGetBoatStates(&testOwnField) == 0) {
+            resCount++;
+        }
+    }
+    // Guesses must come back within the budget plus 1ms of slack, allowing for the odd one that
+    // the host OS preempted.
+    if (late * 20 <= shots) {
+        resCount++;
+    }
+    if (resCount == 21) {
+        printf("PASSED: 21/21 TESTS PASSED (%d.%02d shots per game, %lu samples per guess)\n",
+                shots / 20, shots * 5 % 100, (unsigned long) (samples / shots));
+    } else {
+        printf("FAILED: %d/21 TESTS PASSED (%d late guesses)\n", resCount, late);
+    }
 
     BOARD_End();
+#ifdef PIC32
     while(1);
+#endif
+    return 0;
 } 
 
@@ -21,14 +21,27 @@
 #include "Agent.h"
 #include "Negotiation.h"
 #include "Message.h"
+#include "MessageBinary.h"
 #include "Field.h"
+#include "EventQueue.h"
+#include "Link.h"
 
 //The following Macro switches provide useful debugging tools:
 
 //Trace Mode:  Print a trace of events as they are detected:
 //#define TRACE_MODE
 
-//Unseeded Mode:  Do not reseed rand, and seed with switches (useful for creating repeatable tests):
+//Throttled Transmission Mode:  Send one character every TRANSMIT_PERIOD instead of handing whole
+//messages to the UART (slow enough to watch the traffic):
+//#define THROTTLED_TRANSMISSION_MODE
+
+//Link Negotiation Mode:  Offer capabilities before each challenge (see Link.h).  Only enable it
+//when the opponent runs this firmware too: older firmware treats a CAP message as an error and
+//ends the game.  Offers from the opponent are answered either way:
+//#define LINK_NEGOTIATION_MODE
+
+//Unseeded Mode:  Do not stir the agent's random numbers, and seed them with switches (useful for
+//creating repeatable tests):
 //#define UNSEEDED_MODE
 
 // <editor-fold defaultstate="collapsed" desc="macros for trace mode">
@@ -42,48 +55,95 @@
 // <editor-fold defaultstate="collapsed" desc="macros for unseeded mode">
 #ifdef UNSEEDED_MODE
 #define seed_rand(x) 
-#define AgentInit() {srand(SWITCH_STATES()); AgentInit();}
+#define AgentInit() {AgentSeedRandom(SWITCH_STATES()); AgentInit();}
 #else
-#define seed_rand(x) srand(x)
+#define seed_rand(x) AgentStirRandom(x)
 #endif
 // </editor-fold>
 
 
-//The amount of time between UART updates (in 100ths of a second)
+//The amount of time between UART updates (in 100ths of a second).  Only characters sent in
+//THROTTLED_TRANSMISSION_MODE are paced by it; otherwise whole messages go out at the baud rate.
 #define TRANSMIT_PERIOD 10
 
 /**
  *  Static data for BattleBoats top level:
  */
 
-//This is the top-level event flag:
-static BB_Event battleboatEvent;
+//Top-level events wait in one queue per producer, so none can overwrite another.  The main
+//loop is the only consumer of all three:
+static EventQueue timerEvents; //buttons (and throttled MESSAGE_SENT), from TimerInterrupt100Hz()
+static EventQueue uartEvents; //MESSAGE_SENT, from the UART interrupt
+static EventQueue receivedEvents; //decoded messages, from Transmission_ReceiveAll()
+static EventQueue * const eventQueues[] = {&timerEvents, &uartEvents, &receivedEvents};
+#define NUM_EVENT_QUEUES (sizeof (eventQueues) / sizeof (eventQueues[0]))
+
+//A freerunning timer, counted by TimerInterrupt100Hz(), is used to inject randomness using
+//external events, and to throttle the outgoing transmission speed:
+static volatile uint32_t freerunning_timer = 0;
+
+#ifndef UNSEEDED_MODE
+//The time of the last button press, for the main loop to stir into the Agent's random numbers
+//(the Agent may be drawing from them when the button interrupt fires), or 0 once stirred:
+static volatile uint32_t button_entropy = 0;
+#endif
 
-//A freerunning timer is used to inject randomness using external events,
-//and to throttle the outgoing transmission speed:
-static uint32_t freerunning_timer = 0;
+//The main loop idles the CPU whenever it has nothing to do.  The core timer ticks it spends
+//awake, against the freerunning_timer ticks, give its duty cycle:
+static uint64_t busy_ticks = 0;
+static uint32_t busy_start = 0;
+#define CORE_TICKS_PER_TIMER_TICK (BOARD_CORE_TICKS_PER_MS * 10)
 
 /*
  * The Transmission Outgoing submodule has two states.  It can only send one message at a time,
  * so new outgoing messages can only be started when it is in IDLE mode. 
  * 
- * An indexed buffer stores the message until it is completely sent.
+ * The message is encoded straight into the UART's transmit buffer and sent whole, and the UART
+ * interrupt reports when its last byte has gone out.  Only when that buffer has too little room
+ * before it wraps is the message staged in outgoing_message_buffer.  In
+ * THROTTLED_TRANSMISSION_MODE that indexed buffer always stores the message, until
+ * Transmission_SendChar() has sent it one character at a time.
+ *
+ * Messages are text, or binary frames once the Link has agreed on them with the opponent (see
+ * Link.h); CAP messages are always text.  The UART interrupt (or, when throttled, the Timer2
+ * interrupt) returns the state to IDLE.
  */
-enum {
+volatile enum {
     SENDING, IDLE
 } transmission_state = IDLE;
-static char outgoing_message_buffer[MESSAGE_MAX_LEN + 1];
+static uint8_t outgoing_message_buffer[MESSAGE_MAX_LEN + 1];
 static int outgoing_index = 0;
+#ifdef THROTTLED_TRANSMISSION_MODE
+static int outgoing_length = 0;
+#endif
+static uint8_t outgoing_link_message = FALSE; //a CAP message or a resend, kept from the Agent
+static volatile uint8_t transmission_binary = FALSE; //send and receive binary frames
+static MessageBinaryDecoder binary_decoder;
+
+/**
+ * Encodes a message into `buffer`, as a binary frame if the link has agreed on them, and returns
+ * its length.  `buffer` needs room for MESSAGE_MAX_LEN + 1 bytes.
+ */
+static int Transmission_Encode(uint8_t *buffer, const Message *message)
+{
+    if (transmission_binary && message->type != MESSAGE_CAP) {
+        return MessageBinary_Encode(buffer, *message);
+    }
+    return Message_Encode((char *) buffer, *message);
+}
 
 /**
- * This function copies a message into the Transmission outgoing message buffer and begins
- * the sending process.   Once this function is called, the Transmission module
- * switches into the SENDING state.
+ * This function encodes a message for sending and begins the sending process.  Once this function
+ * is called, the Transmission module switches into the SENDING state.
  * 
  * This function should not be called if it is already in the SENDING state!
  */
 void Transmission_StartSendingMessage(const Message * message_to_send)
 {
+    int length;
+    uint16_t space;
+    uint8_t *span;
+
     //this should only be called if sender is in IDLE.
     switch (transmission_state) {
     case SENDING:
@@ -94,14 +154,56 @@ void Transmission_StartSendingMessage(const Message * message_to_send)
         OledUpdate();
         FATAL_ERROR();
     case IDLE:
-        //copy message into sending buffer:
-        Message_Encode(outgoing_message_buffer, *message_to_send);
         outgoing_index = 0;
         //switch into sending mode:
         transmission_state = SENDING;
+#ifndef THROTTLED_TRANSMISSION_MODE
+        //encode the message where the UART will send it from, if the whole message (and the
+        //'\0' Message_Encode() ends it with) fits before the transmit buffer wraps, and send all
+        //of it; Transmission_MessageSent() is called once it is out:
+        span = Uart1GetWriteSpan(&space);
+        if (space > MESSAGE_MAX_LEN) {
+            length = Transmission_Encode(span, message_to_send);
+            Uart1CommitWrite(length);
+        } else {
+            length = Transmission_Encode(outgoing_message_buffer, message_to_send);
+            Uart1WriteData(outgoing_message_buffer, length);
+        }
+#else
+        //copy message into sending buffer:
+        (void) length, (void) space, (void) span;
+        outgoing_length = Transmission_Encode(outgoing_message_buffer, message_to_send);
+#endif
     }
 }
 
+/**
+ * Returns to IDLE once the whole message is out.  The Agent hears of its own messages through a
+ * MESSAGE_SENT event in `events`; the Link's own are finished by Link_MessageSent().
+ */
+static void Transmission_Finished(EventQueue *events)
+{
+    BB_Event sent = {BB_EVENT_MESSAGE_SENT, 0, 0, 0};
+    transmission_state = IDLE;
+    if (outgoing_link_message) {
+        outgoing_link_message = FALSE;
+        Link_MessageSent();
+    } else {
+        EventQueue_Push(events, &sent);
+    }
+}
+
+/**
+ * Called from the UART interrupt once the whole message has left the UART.  Trace output also
+ * goes through the UART, so this only counts while a message is being sent.
+ */
+void Transmission_MessageSent(void)
+{
+    if (transmission_state != SENDING) return;
+    Transmission_Finished(&uartEvents);
+}
+
+#ifdef THROTTLED_TRANSMISSION_MODE
 /**
  * If an outgoing message is in the buffer, this module sends one character each
  * time it is called.  When the message is sent, the module switches to IDLE mode.
@@ -112,42 +214,89 @@ void Transmission_SendChar(void)
     //if in SENDING, send one char.  Otherwise, do nothing.
     if (transmission_state != SENDING) return;
 
-    //First send our current char:
-    char to_send = outgoing_message_buffer[outgoing_index];
-    if (to_send == '\0') {
+    //First send our current char (binary frames contain a zero byte, so count them):
+    if (outgoing_index == outgoing_length) {
         //this means our message is fully transmitted.
-        battleboatEvent.type = BB_EVENT_MESSAGE_SENT;
         outgoing_index = 0;
-        transmission_state = IDLE;
+        Transmission_Finished(&timerEvents);
         return;
     } else {
-        Uart1WriteByte(to_send);
+        Uart1WriteByte(outgoing_message_buffer[outgoing_index]);
         outgoing_index++;
     }
 }
+#endif
 
-/**
- * Check for incoming messages.  This module uses Message_Decode to parse messages
- * in the UART input stream, and generates events if any messages are detected.
- **/
-void Transmission_ReceiveChar(void)
+/*
+ * The hooks the Link sends through (see LinkTransmission).
+ */
+static void Transmission_LinkSend(const Message *message, uint8_t fromAgent)
 {
-    unsigned char incoming_char;
+    outgoing_link_message = !fromAgent;
+    Transmission_StartSendingMessage(message);
+}
 
-    //read from the UART (if there is anything to read:
-    if (!Uart1HasData()) return;
-    Uart1ReadByte(&incoming_char);
+static uint8_t Transmission_IsIdle(void)
+{
+    return transmission_state == IDLE;
+}
 
-    // the commented line below is very handy for debugging Message_Decode
-    debug_printf("%c | %02x\n", incoming_char, incoming_char);
+static void Transmission_SetBinary(uint8_t binary)
+{
+    MessageBinary_DecoderInit(&binary_decoder);
+    transmission_binary = binary;
+}
 
-    //react to incoming char:
-    if (incoming_char != '\0') {
-        Message_Decode(incoming_char, &battleboatEvent);
-    }
+static uint32_t Transmission_Now(void)
+{
+    return freerunning_timer;
+}
 
-    //also, re-seed our random number using the time:
-    seed_rand(rand() + freerunning_timer);
+static const LinkTransmission transmission_link = {
+    Transmission_LinkSend, Transmission_IsIdle, Transmission_SetBinary, Transmission_Now
+};
+
+/**
+ * Check for incoming messages.  This module uses Message_Decode (or MessageBinary_DecodeWith,
+ * once the link has agreed on binary frames) to parse every character
+ * waiting in the UART input stream, where it is in the UART's receive buffer, and queues an event
+ * for each message detected.  A burst of
+ * characters can complete several messages at once; their events wait in receivedEvents until
+ * the Agent has handled the ones before them.
+ **/
+void Transmission_ReceiveAll(void)
+{
+    const uint8_t *incoming;
+    uint16_t length, i;
+    BB_Event decoded_event;
+
+    //read from the UART, a contiguous span of its buffer at a time, until there is nothing left:
+    while ((incoming = Uart1GetReadSpan(&length)), length > 0) {
+        for (i = 0; i < length; i++) {
+            // the commented line below is very handy for debugging Message_Decode
+            debug_printf("%c | %02x\n", incoming[i], incoming[i]);
+
+            //react to incoming char, framed as the link has agreed:
+            if (transmission_binary) {
+                MessageBinary_DecodeWith(&binary_decoder, incoming[i], &decoded_event);
+            } else if (incoming[i] != '\0') {
+                Message_Decode(incoming[i], &decoded_event);
+            } else {
+                continue;
+            }
+            if (decoded_event.type == BB_EVENT_CAP_RECEIVED) {
+                //capabilities are for the link, not the Agent:
+                Link_Receive(decoded_event);
+            } else if (decoded_event.type != BB_EVENT_NO_EVENT && Link_Accept(&decoded_event)) {
+                EventQueue_Push(&receivedEvents, &decoded_event);
+            }
+
+            //also, stir the time into our random numbers:
+            seed_rand(freerunning_timer);
+        }
+        //the span has been decoded; let the UART reuse it:
+        Uart1CommitRead(length);
+    }
 }
 
 //Functions that stringify state names and event names for display.
@@ -157,7 +306,7 @@ void Transmission_ReceiveChar(void)
 
 void TraceState(void)
 {
-    char tracestr[100] = "---TRACE:  Current state=";
+    char tracestr[200] = "---TRACE:  Current state=";
     switch (AgentGetState()) {
         printcase(AGENT_STATE_START);
         printcase(AGENT_STATE_CHALLENGING);
@@ -168,14 +317,26 @@ void TraceState(void)
         printcase(AGENT_STATE_END_SCREEN);
     default: return;
     }
-    strcat(tracestr, "\n");
+    //the queue diagnostics: most events ever waiting / events dropped
+    sprintf(tracestr + strlen(tracestr), " (queues: timer %lu/%lu, uart %lu/%lu, rx %lu/%lu",
+            (unsigned long) timerEvents.highWater, (unsigned long) timerEvents.overflows,
+            (unsigned long) uartEvents.highWater, (unsigned long) uartEvents.overflows,
+            (unsigned long) receivedEvents.highWater, (unsigned long) receivedEvents.overflows);
+    //and the share of time the CPU has been awake, in tenths of a percent:
+    uint64_t elapsed = (uint64_t) freerunning_timer * CORE_TICKS_PER_TIMER_TICK;
+    uint64_t busy = busy_ticks + (uint32_t) (BOARD_GetCoreTimer() - busy_start);
+    unsigned long permille = elapsed ? (unsigned long) (busy * 1000 / elapsed) : 0;
+    if (permille > 1000) permille = 1000;
+    sprintf(tracestr + strlen(tracestr), ", cpu %lu.%lu%% busy, link %lu baud %s)\n",
+            permille / 10, permille % 10, (unsigned long) Link_BaudRate(),
+            transmission_binary ? "binary" : "text");
     Uart1WriteData(tracestr, strlen(tracestr));
 }
 
-void TraceEvent(void)
+void TraceEvent(BB_Event event)
 {
     char tracestr[100] = "---TRACE:  Detected Event: ";
-    switch (battleboatEvent.type) {
+    switch (event.type) {
         printcase(BB_EVENT_NO_EVENT);
         printcase(BB_EVENT_START_BUTTON);
         printcase(BB_EVENT_RESET_BUTTON);
@@ -188,22 +349,108 @@ void TraceEvent(void)
         printcase(BB_EVENT_RES_RECEIVED);
         printcase(BB_EVENT_MESSAGE_SENT);
         printcase(BB_EVENT_ERROR);
+        printcase(BB_EVENT_CAP_RECEIVED);
+        printcase(BB_EVENT_RAS_RECEIVED);
     }
-    sprintf(tracestr, "%s - %d,%d,%d\n", tracestr,
-            battleboatEvent.param0, battleboatEvent.param1, battleboatEvent.param2);
+    sprintf(tracestr + strlen(tracestr), " - %d,%d,%d\n",
+            event.param0, event.param1, event.param2);
     Uart1WriteData(tracestr, strlen(tracestr));
 }
 
 #else
-#define TraceEvent() 
+#define TraceEvent(event)
 #define TraceState()
 #endif
 // </editor-fold>
 
+/**
+ * Passes one event to the Agent and sends its reply, if it has one.
+ */
+static void RunAgent(BB_Event event)
+{
+    TraceEvent(event);
+
+    Message message_to_send = AgentRun(event);
+
+    //a new game negotiates its own link:
+    if (event.type == BB_EVENT_RESET_BUTTON) {
+        Link_Reset();
+    }
+
+    TraceState();
+
+    //send a message, if there is one to send:
+    if (message_to_send.type != MESSAGE_NONE) {
+        Link_SendMessage(&message_to_send);
+    }
+}
+
+/**
+ * Drains every event queue into the Agent.  Each pass takes the events that were waiting in each
+ * queue, in the order buttons, MESSAGE_SENT, received messages, and passes repeat until all of
+ * the queues are empty.
+ */
+static void DispatchEvents(void)
+{
+    BB_Event event;
+    uint8_t dispatched;
+    unsigned int i;
+
+    do {
+        dispatched = FALSE;
+        for (i = 0; i < NUM_EVENT_QUEUES; i++) {
+            uint32_t waiting = EventQueue_Count(eventQueues[i]);
+            while (waiting-- > 0 && EventQueue_Pop(eventQueues[i], &event)) {
+                RunAgent(event);
+                dispatched = TRUE;
+            }
+        }
+    } while (dispatched);
+}
+
+/**
+ * Idles the CPU until an interrupt, unless an event, a received byte or a switch of capabilities
+ * is already waiting.
+ * Everything the main loop reacts to arrives by interrupt: received bytes and MESSAGE_SENT from
+ * the UART interrupt, and buttons from the Timer2 interrupt that polls them.  Interrupts are
+ * disabled from the check until the wait is over, so one that arrives in between still ends the
+ * wait instead of being missed until the next.
+ */
+static void WaitForEvents(void)
+{
+    unsigned int i;
+    uint32_t interrupts = BOARD_DisableInterrupts();
+
+    if (Uart1HasData() || Link_SwitchDue()) {
+        BOARD_RestoreInterrupts(interrupts);
+        return;
+    }
+    for (i = 0; i < NUM_EVENT_QUEUES; i++) {
+        if (EventQueue_Count(eventQueues[i]) > 0) {
+            BOARD_RestoreInterrupts(interrupts);
+            return;
+        }
+    }
+
+    busy_ticks += (uint32_t) (BOARD_GetCoreTimer() - busy_start);
+    BOARD_WaitForInterrupt();
+    busy_start = BOARD_GetCoreTimer();
+
+    //the interrupt that woke us is serviced here:
+    BOARD_RestoreInterrupts(interrupts);
+}
+
 int main()
 {
+    unsigned int i;
+
     BOARD_Init();
 
+    //Empty the event queues before any interrupt can fill them:
+    for (i = 0; i < NUM_EVENT_QUEUES; i++) {
+        EventQueue_Init(eventQueues[i]);
+    }
+
     // Set up UART1 for output.
     // <editor-fold defaultstate="collapsed" desc="Configure Timers and UART">
     Uart1Init(UART_BAUD_RATE); // Configure Timer 2 using PBCLK as input. We configure it using a 1:16 prescalar, so each timer
@@ -224,6 +471,10 @@ int main()
 
     // Disable buffering on stdout
     setbuf(stdout, NULL);
+
+#ifndef THROTTLED_TRANSMISSION_MODE
+    Uart1SetTxDoneCallback(Transmission_MessageSent);
+#endif
     // </editor-fold>
 
     //Set up LEDs:
@@ -241,32 +492,40 @@ int main()
     //Initialize Agent module:
     AgentInit();
 
+    //and the Link it sends through:
+#ifdef LINK_NEGOTIATION_MODE
+    Link_Init(&transmission_link, TRUE);
+#else
+    Link_Init(&transmission_link, FALSE);
+#endif
+
     TraceState();
 
     //Main loop:
+    busy_start = BOARD_GetCoreTimer();
     while (TRUE) {
+#ifndef UNSEEDED_MODE
+        //stir the time of the last button press into our random numbers:
+        if (button_entropy != 0) {
+            seed_rand(button_entropy);
+            button_entropy = 0;
+        }
+#endif
 
-        //if there is a top-level event, the Agent module should respond to it:
-        if (battleboatEvent.type != BB_EVENT_NO_EVENT) {
-
-            TraceEvent();
-
-            Message message_to_send = AgentRun(battleboatEvent);
-
-            TraceState();
+        //decode everything that has arrived since the last pass:
+        Transmission_ReceiveAll();
 
-            //send a message, if there is one to send:
-            if (message_to_send.type != MESSAGE_NONE) {
-                Transmission_StartSendingMessage(&message_to_send);
-            }
+        //switch capabilities, send held messages and recover lost ones:
+        Link_Update();
 
-            //consume the event:
-            battleboatEvent.type = BB_EVENT_NO_EVENT;
-
-        }
+        //the Agent module should respond to every top-level event:
+        DispatchEvents();
 
         //update the LEDs to show the agent's current state:
         LATE = (1 << AgentGetState()); //this is very fast so we can do it directly in while(1) loop
+
+        //and sleep until an interrupt brings something new:
+        WaitForEvents();
     }
 }
 
@@ -285,19 +544,34 @@ void __ISR(_TIMER_2_VECTOR, ipl4auto) TimerInterrupt100Hz(void)
     // Check for any button events
     uint8_t buttonEvent = ButtonsCheckEvents();
 
-    if (buttonEvent & BUTTON_EVENT_4DOWN) battleboatEvent.type = BB_EVENT_START_BUTTON;
-    if (buttonEvent & BUTTON_EVENT_3DOWN) battleboatEvent.type = BB_EVENT_EAST_BUTTON;
-    if (buttonEvent & BUTTON_EVENT_2DOWN) battleboatEvent.type = BB_EVENT_SOUTH_BUTTON;
-    if (buttonEvent & BUTTON_EVENT_1DOWN) battleboatEvent.type = BB_EVENT_RESET_BUTTON;
+    BB_Event button = {BB_EVENT_NO_EVENT, 0, 0, 0};
+    if (buttonEvent & BUTTON_EVENT_4DOWN) {
+        button.type = BB_EVENT_START_BUTTON;
+        EventQueue_Push(&timerEvents, &button);
+    }
+    if (buttonEvent & BUTTON_EVENT_3DOWN) {
+        button.type = BB_EVENT_EAST_BUTTON;
+        EventQueue_Push(&timerEvents, &button);
+    }
+    if (buttonEvent & BUTTON_EVENT_2DOWN) {
+        button.type = BB_EVENT_SOUTH_BUTTON;
+        EventQueue_Push(&timerEvents, &button);
+    }
+    if (buttonEvent & BUTTON_EVENT_1DOWN) {
+        button.type = BB_EVENT_RESET_BUTTON;
+        EventQueue_Push(&timerEvents, &button);
+    }
 
-    //also, re-seed our random number using the time:
-    if (buttonEvent) seed_rand(rand() + freerunning_timer);
+#ifndef UNSEEDED_MODE
+    //also, leave the time for the main loop to stir into our random numbers:
+    if (buttonEvent) button_entropy = freerunning_timer;
+#endif
 
-    //every TRANSMIT_PERIOD cycles, attempt to run the transmission module.
+#ifdef THROTTLED_TRANSMISSION_MODE
+    //every TRANSMIT_PERIOD cycles, send the next character.
     if (freerunning_timer % TRANSMIT_PERIOD == 0) {
         Transmission_SendChar();
-        if (battleboatEvent.type == BB_EVENT_MESSAGE_SENT) return;
-        Transmission_ReceiveChar();
     }
+#endif
 
 }
\ No newline at end of file
@@ -0,0 +1,262 @@
+/*
+ * File:   Link.c
+ *
+ * The Link between the Agent and the transmission of its messages. See Link.h.
+ */
+
+#include "Link.h"
+#include "Agent.h"
+#include "BOARD.h"
+#include "Capability.h"
+#include "Uart1.h"
+
+static const LinkTransmission *link_transmission;
+static uint8_t link_offer = TRUE; //offer capabilities before a challenge
+
+static enum {
+    LINK_DEFAULT, LINK_OFFERED, LINK_NEGOTIATED
+} link_state = LINK_DEFAULT;
+static uint16_t link_supported = CAPABILITY_SUPPORTED; //what we offer
+static uint16_t link_capabilities = 0; //what both boards support, once negotiated
+static uint16_t link_in_use = 0; //what the link runs with now
+static uint8_t link_switch_pending = FALSE; //switch once our answer is sent
+static volatile uint8_t link_switch_due = FALSE; //our answer is sent, so switch now
+static volatile uint32_t link_baud_rate = UART_BAUD_RATE; //what the UART runs at
+static uint8_t link_binary = FALSE; //what the transmission frames messages as
+static Message link_held_message = {MESSAGE_NONE, 0, 0, 0};
+static uint8_t link_held_resend = FALSE; //the held message has been sent before
+static uint8_t link_offer_expired = FALSE; //we gave up on our offer and challenged in text
+static uint32_t link_timer = 0; //when the offer went out, or the answer came in
+static uint16_t link_errors = 0; //messages that failed to decode since the agreement
+static Message link_last_sent = {MESSAGE_NONE, 0, 0, 0}; //the Agent's, for resending
+static uint32_t link_sent_timer = 0;
+static BB_Event link_last_heard = {BB_EVENT_NO_EVENT, 0, 0, 0}; //to recognize it if resent
+static uint32_t link_heard_timer = 0; //when something new last arrived
+static uint8_t link_resends = 0; //since something new last arrived
+
+void Link_Init(const LinkTransmission *transmission, uint8_t offer)
+{
+    link_transmission = transmission;
+    link_offer = offer;
+    link_state = LINK_DEFAULT;
+    link_supported = CAPABILITY_SUPPORTED;
+    link_capabilities = 0;
+    link_in_use = 0;
+    link_switch_pending = FALSE;
+    link_switch_due = FALSE;
+    link_baud_rate = UART_BAUD_RATE;
+    link_binary = FALSE;
+    link_held_message.type = MESSAGE_NONE;
+    link_held_resend = FALSE;
+    link_offer_expired = FALSE;
+    link_errors = 0;
+    link_last_sent.type = MESSAGE_NONE;
+    link_last_heard.type = BB_EVENT_NO_EVENT;
+    link_heard_timer = transmission->now();
+    link_resends = 0;
+}
+
+/**
+ * Moves the UART to the fastest baud rate in `capabilities`, or the default rate, frames
+ * messages as binary if `capabilities` includes CAPABILITY_BINARY_FRAMES, or as text, and has the
+ * Agent combine its turns if it includes CAPABILITY_COMBINED_TURNS.
+ */
+static void Link_Use(uint16_t capabilities)
+{
+    uint8_t binary = (capabilities & CAPABILITY_BINARY_FRAMES) != 0;
+    link_in_use = capabilities;
+    if (Capability_BaudRate(capabilities) != link_baud_rate) {
+        link_baud_rate = Capability_BaudRate(capabilities);
+        Uart1ChangeBaudRate(Capability_BaudRateBrg(capabilities));
+    }
+    if (binary != link_binary) {
+        link_binary = binary;
+        link_transmission->setBinary(binary);
+    }
+    AgentSetCombinedTurns((capabilities & CAPABILITY_COMBINED_TURNS) != 0);
+}
+
+/**
+ * Sends a CAP message.
+ */
+static void Link_SendCapabilities(uint16_t capabilities, uint16_t offerOrAnswer)
+{
+    Message cap = {MESSAGE_CAP, capabilities, offerOrAnswer, 0};
+    link_transmission->send(&cap, FALSE);
+}
+
+/**
+ * Sends the Agent's last message again, unless the transmission is busy or a newer one is waiting
+ * to go.
+ */
+static void Link_Resend(void)
+{
+    if (link_last_sent.type == MESSAGE_NONE || link_held_message.type != MESSAGE_NONE ||
+            !link_transmission->idle()) return;
+    link_sent_timer = link_transmission->now();
+    link_transmission->send(&link_last_sent, FALSE);
+}
+
+void Link_SendMessage(const Message *message)
+{
+    link_last_sent = *message;
+    link_sent_timer = link_transmission->now();
+    //the opponent heard our CHA, so an answer that arrives now is stale:
+    link_offer_expired = FALSE;
+    if (message->type == MESSAGE_CHA && link_state == LINK_DEFAULT && link_offer &&
+            link_supported) {
+        link_held_message = *message;
+        link_timer = link_transmission->now();
+        link_state = LINK_OFFERED;
+        Link_SendCapabilities(link_supported, CAPABILITY_OFFER);
+        return;
+    }
+    if (!link_transmission->idle()) {
+        link_held_message = *message;
+        link_held_resend = FALSE;
+        return;
+    }
+    link_transmission->send(message, TRUE);
+}
+
+void Link_MessageSent(void)
+{
+    if (link_switch_pending) {
+        link_switch_due = TRUE;
+    }
+}
+
+void Link_Receive(BB_Event event)
+{
+    if (event.param1 == CAPABILITY_ANSWER) {
+        if (link_state == LINK_DEFAULT && link_offer_expired) {
+            //a late answer, after we gave up and challenged at the default rate: the opponent
+            //switched once it was sent, so our CHA was lost, and goes again at the new rate:
+            link_held_message = link_last_sent;
+            link_held_resend = TRUE;
+        } else if (link_state != LINK_OFFERED) {
+            return;
+        }
+        link_offer_expired = FALSE;
+        link_capabilities = event.param0 & link_supported;
+        Link_Use(link_capabilities);
+        link_timer = link_transmission->now();
+        link_state = LINK_NEGOTIATED;
+    } else {
+        //if both boards offered at once, neither answers, and both time out:
+        if (link_state == LINK_OFFERED || !link_transmission->idle()) return;
+        link_capabilities = event.param0 & link_supported;
+        link_switch_pending = TRUE;
+        link_state = LINK_NEGOTIATED;
+        Link_SendCapabilities(link_capabilities, CAPABILITY_ANSWER);
+    }
+    link_errors = 0;
+    link_heard_timer = link_transmission->now();
+    link_resends = 0;
+}
+
+uint8_t Link_Accept(const BB_Event *event)
+{
+    if (link_state != LINK_NEGOTIATED) return TRUE;
+    if (event->type == BB_EVENT_ERROR) {
+        link_errors++;
+        return FALSE;
+    }
+    if (event->type == link_last_heard.type && event->param0 == link_last_heard.param0 &&
+            event->param1 == link_last_heard.param1 && event->param2 == link_last_heard.param2) {
+        //the opponent has not heard our answer to it:
+        if (link_transmission->now() - link_sent_timer >= LINK_RESEND_HOLDOFF) {
+            Link_Resend();
+        }
+        return FALSE;
+    }
+    link_last_heard = *event;
+    link_heard_timer = link_transmission->now();
+    link_resends = 0;
+    return TRUE;
+}
+
+/**
+ * Returns to text at the default rate, keeping only the capabilities that do not depend on the
+ * line. If messages failed to decode, the rate in use is not offered again, nor are binary
+ * frames if they were used at the default rate.
+ */
+static void Link_FallBack(void)
+{
+    uint16_t kept = link_capabilities & ~(CAPABILITY_BAUDS | CAPABILITY_BINARY_FRAMES);
+    if (link_in_use == kept) return;
+    if (link_errors > 0) {
+        link_supported = Capability_DropBaudRate(link_supported, link_in_use);
+        if (link_baud_rate == UART_BAUD_RATE) {
+            link_supported &= ~CAPABILITY_BINARY_FRAMES;
+        }
+    }
+    Link_Use(kept);
+}
+
+/**
+ * A held CHA is sent LINK_SWITCH_DELAY after the answer arrived, or at the default rate once the
+ * offer has gone unanswered for LINK_OFFER_TIMEOUT. A CHA sent again after a late answer waits
+ * LINK_SWITCH_DELAY too. A message held behind a resend goes as soon as the resend is out.
+ */
+void Link_Update(void)
+{
+    uint32_t now = link_transmission->now();
+
+    if (link_switch_due) {
+        link_switch_due = FALSE;
+        link_switch_pending = FALSE;
+        Link_Use(link_capabilities);
+    }
+
+    if (link_state == LINK_NEGOTIATED && now - link_heard_timer >= LINK_SILENCE_TIMEOUT) {
+        link_heard_timer = now;
+        Link_FallBack();
+        if (AgentGetState() != AGENT_STATE_START && AgentGetState() != AGENT_STATE_END_SCREEN &&
+                link_resends < LINK_RESEND_LIMIT) {
+            link_resends++;
+            Link_Resend();
+        }
+    }
+
+    if (link_held_message.type == MESSAGE_NONE || !link_transmission->idle()) return;
+    if (link_state == LINK_OFFERED) {
+        if (now - link_timer < LINK_OFFER_TIMEOUT) return;
+        link_state = LINK_DEFAULT;
+        link_offer_expired = TRUE;
+    } else if (link_state == LINK_NEGOTIATED && now - link_timer < LINK_SWITCH_DELAY) {
+        return;
+    }
+    if (link_held_resend) {
+        link_sent_timer = now;
+    }
+    link_transmission->send(&link_held_message, !link_held_resend);
+    link_held_message.type = MESSAGE_NONE;
+    link_held_resend = FALSE;
+}
+
+uint8_t Link_SwitchDue(void)
+{
+    return link_switch_due;
+}
+
+void Link_Reset(void)
+{
+    link_held_message.type = MESSAGE_NONE;
+    link_held_resend = FALSE;
+    link_offer_expired = FALSE;
+    link_last_sent.type = MESSAGE_NONE;
+    link_last_heard.type = BB_EVENT_NO_EVENT;
+    link_switch_pending = FALSE;
+    link_switch_due = FALSE;
+    if (link_state == LINK_NEGOTIATED) {
+        link_capabilities = 0;
+        Link_Use(0);
+    }
+    link_state = LINK_DEFAULT;
+}
+
+uint32_t Link_BaudRate(void)
+{
+    return link_baud_rate;
+}
@@ -0,0 +1,132 @@
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdint.h>
+#include "BattleBoats.h"
+#include "Message.h"
+
+/**
+ * The Link sits between the Agent and the transmission of its messages, and agrees on capabilities
+ * with the opponent before each game (see Capability.h). When the Agent challenges, and offers are
+ * on (see Link_Init()), its CHA is held back and a CAP offer goes out first. The opponent answers
+ * with the capabilities both boards share, and switches to the fastest shared baud rate as soon as
+ * its answer has left the UART. The challenger switches when the answer arrives, then waits
+ * LINK_SWITCH_DELAY before sending the CHA, so the switch falls cleanly between the two messages.
+ * If no answer comes within LINK_OFFER_TIMEOUT, the CHA goes out at the default rate. If the answer
+ * comes later, the opponent has switched already, so the challenger switches too, and sends the CHA
+ * again LINK_SWITCH_DELAY later. Binary frames, if both boards support them, start at the same
+ * moments as the new rate, so the CHA is the challenger's first binary frame. So do combined turns,
+ * well before the first SHO.
+ *
+ * Once the boards have agreed, each knows the other runs this firmware, and a lost message no
+ * longer ends the game. A message that fails to decode is dropped instead of reaching the Agent.
+ * If nothing new arrives for LINK_SILENCE_TIMEOUT, both boards take it that a message was lost:
+ * each returns to text at the default rate, and if its Agent is mid-game, sends its last message
+ * again, up to LINK_RESEND_LIMIT times. The board waiting for the lost message heard from the
+ * other one before the other heard from it, so it times out and switches first, and the resent
+ * message reaches it. A message that arrives twice is dropped too, and tells the receiver that
+ * its own last message was lost, so it sends that again. If messages failed to decode before the
+ * switch, the rate is not offered again, nor are binary frames if they were used at the default
+ * rate. Resetting the Agent also returns to text at the default rate, ready to negotiate the next
+ * game. Without an agreement, as against older firmware, a bad message still reaches the Agent
+ * and ends the game.
+ *
+ * Times are in ticks of the clock that LinkTransmission.now() reads, 100ths of a second on the
+ * board.
+ */
+#define LINK_OFFER_TIMEOUT 50
+#define LINK_SWITCH_DELAY 2
+#define LINK_SILENCE_TIMEOUT 100
+#define LINK_RESEND_LIMIT 5
+#define LINK_RESEND_HOLDOFF (LINK_SILENCE_TIMEOUT / 2) // Between resends of the same message.
+
+/**
+ * What the Link needs from the transmission below it.
+ */
+typedef struct {
+    /**
+     * Starts sending `message`. Only called while idle() is TRUE. Once the message is out, the
+     * Agent hears of it with a MESSAGE_SENT event if `fromAgent` is set, and Link_MessageSent() is
+     * called if not.
+     */
+    void (*send)(const Message *message, uint8_t fromAgent);
+
+    /**
+     * Returns whether a message can be sent.
+     */
+    uint8_t (*idle)(void);
+
+    /**
+     * Frames every message but CAP as a binary frame if `binary` is set, or as text. The
+     * transmission also decodes what it receives as binary frames or text from now on.
+     */
+    void (*setBinary)(uint8_t binary);
+
+    /**
+     * Returns the time.
+     */
+    uint32_t (*now)(void);
+} LinkTransmission;
+
+/**
+ * Starts the Link with no capabilities, in text at the default rate.
+ *
+ * @param transmission The transmission to send through, which must outlive the Link.
+ * @param offer        Whether to offer capabilities before a challenge. Firmware that predates
+ *                     the Link takes an offer for a bad message and ends the game, so only
+ *                     offer to an opponent known to run this firmware. Offers from the opponent
+ *                     are answered either way.
+ */
+void Link_Init(const LinkTransmission *transmission, uint8_t offer);
+
+/**
+ * Sends a message from the Agent, first offering capabilities if it is a challenge. If the
+ * transmission is busy, the message waits for Link_Update().
+ */
+void Link_SendMessage(const Message *message);
+
+/**
+ * Called by the transmission, from interrupt context, once a message that the Agent did not send
+ * is out. After an answer, this is the moment to switch, which Link_Update() does.
+ */
+void Link_MessageSent(void);
+
+/**
+ * Handles a CAP message from the opponent, which the Agent never hears about.
+ */
+void Link_Receive(BB_Event event);
+
+/**
+ * Decides whether a message from the opponent goes on to the Agent. Once capabilities are
+ * agreed, a message that failed to decode is counted and dropped, and so is one that arrived
+ * before, which also has our last message sent again.
+ *
+ * @return TRUE if the Agent should handle `event`.
+ */
+uint8_t Link_Accept(const BB_Event *event);
+
+/**
+ * Switches to the agreed capabilities once our answer has been sent, sends held messages when
+ * the link is ready for them, and falls back and resends after LINK_SILENCE_TIMEOUT without
+ * anything new from the opponent. Call it from the main loop.
+ */
+void Link_Update(void);
+
+/**
+ * Returns whether Link_Update() has a switch to make. The main loop should not sleep while it
+ * does.
+ */
+uint8_t Link_SwitchDue(void);
+
+/**
+ * Forgets the negotiated capabilities and any held message, returning to text at the default
+ * rate. Call it when the Agent is reset.
+ */
+void Link_Reset(void);
+
+/**
+ * Returns the baud rate the UART runs at.
+ */
+uint32_t Link_BaudRate(void);
+
+#endif // LINK_H
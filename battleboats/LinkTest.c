@@ -0,0 +1,282 @@
+/*
+ * File:   LinkTest.c
+ *
+ * Tests for the Link in Link.c, through a transmission that only records what it is given.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "Agent.h"
+#include "Capability.h"
+#include "Link.h"
+
+/**
+ * The transmission the Link sends through: it keeps the last message, and is idle unless a test
+ * says otherwise.
+ */
+static Message sent;
+static uint8_t sentFromAgent;
+static int sentCount;
+static uint8_t busy;
+static uint8_t binary;
+static uint32_t now;
+
+static void TestSend(const Message *message, uint8_t fromAgent)
+{
+    sent = *message;
+    sentFromAgent = fromAgent;
+    sentCount++;
+}
+
+static uint8_t TestIdle(void)
+{
+    return !busy;
+}
+
+static void TestSetBinary(uint8_t isBinary)
+{
+    binary = isBinary;
+}
+
+static uint32_t TestNow(void)
+{
+    return now;
+}
+
+static const LinkTransmission testTransmission = {TestSend, TestIdle, TestSetBinary, TestNow};
+
+/**
+ * Starts a Link with nothing sent, at time 0.
+ */
+static void TestInit(uint8_t offer)
+{
+    sentCount = 0;
+    busy = FALSE;
+    binary = FALSE;
+    now = 0;
+    Link_Init(&testTransmission, offer);
+}
+
+/**
+ * Runs Link_Update() every tick for `ticks` ticks.
+ */
+static void TestRun(uint32_t ticks)
+{
+    while (ticks-- > 0) {
+        now++;
+        Link_Update();
+    }
+}
+
+int main(int argc, char** argv) {
+    BOARD_Init();
+    AgentInit();
+    int resCount = 0;
+    Message cha = {MESSAGE_CHA, 1234, 0, 0};
+    Message sho = {MESSAGE_SHO, 2, 3, 0};
+    BB_Event answer = {BB_EVENT_CAP_RECEIVED, CAPABILITY_SUPPORTED, CAPABILITY_ANSWER, 0};
+    BB_Event offer = {BB_EVENT_CAP_RECEIVED, CAPABILITY_SUPPORTED, CAPABILITY_OFFER, 0};
+    BB_Event acc = {BB_EVENT_ACC_RECEIVED, 4321, 0, 0};
+    BB_Event error = {BB_EVENT_ERROR, 0, 0, 0};
+    printf("Welcome to the Link.c Test!\n");
+
+    printf("Now Testing Link_SendMessage()\n");
+    // A challenge waits behind an offer of everything we support.
+    TestInit(TRUE);
+    Link_SendMessage(&cha);
+    if (sentCount == 1 && sent.type == MESSAGE_CAP && sent.param0 == CAPABILITY_SUPPORTED &&
+            sent.param1 == CAPABILITY_OFFER && !sentFromAgent) {
+        resCount++;
+    }
+    // Without offers, it goes straight out.
+    TestInit(FALSE);
+    Link_SendMessage(&cha);
+    if (sentCount == 1 && sent.type == MESSAGE_CHA && sentFromAgent) {
+        resCount++;
+    }
+    // Anything sent while the transmission is busy waits for Link_Update().
+    TestInit(TRUE);
+    busy = TRUE;
+    Link_SendMessage(&sho);
+    TestRun(1);
+    busy = FALSE;
+    if (sentCount == 0) {
+        TestRun(1);
+        if (sentCount == 1 && sent.type == MESSAGE_SHO && sentFromAgent) {
+            resCount++;
+        }
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing the challenger's side of Link_Receive()\n");
+    TestInit(TRUE);
+    Link_SendMessage(&cha);
+    Link_Receive(answer);
+    // The challenger switches as soon as the answer arrives.
+    if (Link_BaudRate() == Capability_BaudRate(CAPABILITY_SUPPORTED) && binary) {
+        resCount++;
+    }
+    // Then sends its challenge LINK_SWITCH_DELAY later.
+    TestRun(LINK_SWITCH_DELAY - 1);
+    if (sentCount == 1) {
+        TestRun(1);
+        if (sentCount == 2 && sent.type == MESSAGE_CHA && sentFromAgent) {
+            resCount++;
+        }
+    }
+    // An unanswered offer gives up after LINK_OFFER_TIMEOUT, and challenges at the default rate.
+    TestInit(TRUE);
+    Link_SendMessage(&cha);
+    TestRun(LINK_OFFER_TIMEOUT - 1);
+    if (sentCount == 1) {
+        TestRun(1);
+        if (sentCount == 2 && sent.type == MESSAGE_CHA && Link_BaudRate() == UART_BAUD_RATE &&
+                !binary) {
+            resCount++;
+        }
+    }
+    // An answer after that means the opponent has switched, so the challenger switches too, and
+    // sends its challenge again, without the Agent hearing of it.
+    Link_Receive(answer);
+    TestRun(LINK_SWITCH_DELAY);
+    if (sentCount == 3 && sent.type == MESSAGE_CHA && !sentFromAgent && binary &&
+            Link_BaudRate() == Capability_BaudRate(CAPABILITY_SUPPORTED)) {
+        resCount++;
+    }
+    if (resCount == 4) {
+        printf("PASSED: 4/4 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/4 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing the accepter's side of Link_Receive()\n");
+    TestInit(TRUE);
+    Link_Receive(offer);
+    if (sentCount == 1 && sent.type == MESSAGE_CAP && sent.param0 == CAPABILITY_SUPPORTED &&
+            sent.param1 == CAPABILITY_ANSWER && !sentFromAgent) {
+        resCount++;
+    }
+    // The accepter switches once its answer is out, and not before.
+    TestRun(LINK_SWITCH_DELAY);
+    if (Link_BaudRate() == UART_BAUD_RATE && !Link_SwitchDue()) {
+        Link_MessageSent();
+        if (Link_SwitchDue()) {
+            TestRun(1);
+            if (!Link_SwitchDue() && binary &&
+                    Link_BaudRate() == Capability_BaudRate(CAPABILITY_SUPPORTED)) {
+                resCount++;
+            }
+        }
+    }
+    // Offers are answered even when we do not make them.
+    TestInit(FALSE);
+    Link_Receive(offer);
+    if (sentCount == 1 && sent.type == MESSAGE_CAP && sent.param1 == CAPABILITY_ANSWER) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Link_Accept()\n");
+    // Without an agreement, every message reaches the Agent, errors included.
+    TestInit(TRUE);
+    if (Link_Accept(&error) && Link_Accept(&acc) && Link_Accept(&acc)) {
+        resCount++;
+    }
+    // With one, errors are dropped.
+    Link_Receive(offer);
+    Link_MessageSent();
+    TestRun(1);
+    if (!Link_Accept(&error) && Link_Accept(&acc)) {
+        resCount++;
+    }
+    // A message that arrives twice is dropped, and has our last message sent again.
+    Link_SendMessage(&sho);
+    TestRun(LINK_RESEND_HOLDOFF);
+    sentCount = 0;
+    if (!Link_Accept(&acc) && sentCount == 1 && sent.type == MESSAGE_SHO && !sentFromAgent) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Link_Update()\n");
+    // After LINK_SILENCE_TIMEOUT without anything new, a board mid-game returns to text at the
+    // default rate and resends its last message.
+    TestInit(TRUE);
+    AgentSetState(AGENT_STATE_DEFENDING);
+    Link_Receive(offer);
+    Link_MessageSent();
+    TestRun(1);
+    Link_SendMessage(&sho);
+    sentCount = 0;
+    TestRun(LINK_SILENCE_TIMEOUT - 2);
+    if (sentCount == 0) {
+        TestRun(1);
+        if (sentCount == 1 && sent.type == MESSAGE_SHO && !sentFromAgent &&
+                Link_BaudRate() == UART_BAUD_RATE && !binary) {
+            resCount++;
+        }
+    }
+    // It stops resending after LINK_RESEND_LIMIT.
+    TestRun(10 * LINK_SILENCE_TIMEOUT);
+    if (sentCount == LINK_RESEND_LIMIT) {
+        resCount++;
+    }
+    // A board that is not mid-game does not resend.
+    TestInit(TRUE);
+    AgentSetState(AGENT_STATE_START);
+    Link_Receive(offer);
+    Link_MessageSent();
+    TestRun(1);
+    sentCount = 0;
+    TestRun(LINK_SILENCE_TIMEOUT);
+    if (sentCount == 0 && Link_BaudRate() == UART_BAUD_RATE) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Link_Reset()\n");
+    TestInit(TRUE);
+    Link_SendMessage(&cha);
+    Link_Receive(answer);
+    Link_Reset();
+    if (Link_BaudRate() == UART_BAUD_RATE && !binary) {
+        resCount++;
+    }
+    // The held challenge is forgotten, and the next one offers again.
+    TestRun(LINK_OFFER_TIMEOUT);
+    if (sentCount == 1) {
+        Link_SendMessage(&cha);
+        if (sentCount == 2 && sent.type == MESSAGE_CAP) {
+            resCount++;
+        }
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    return (EXIT_SUCCESS);
+}
@@ -1,18 +1,585 @@
-/* 
+/*
  * File:   Message.c
  * Author: ryryd
  *
  * Created on December 5, 2023, 11:54 AM
  */
 
-#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+#include "Message.h"
+#include "BOARD.h"
 
-/*
- * 
+/**
+ * The states of the Message_Decode() state machine.
+ */
+typedef enum {
+    WAITING_FOR_START_DELIMITER,
+    RECORDING_TAG,
+    RECORDING_FIELDS,
+    RECORDING_CHECKSUM,
+} DecodeState;
+
+static MessageDecoder defaultDecoder;
+
+/**
+ * Packs a three-letter tag into an integer, first letter highest, as the decoder builds it.
+ */
+#define MESSAGE_TAG(a, b, c) (((uint32_t) (a) << 16) | ((uint32_t) (b) << 8) | (uint32_t) (c))
+
+/**
+ * The message types that can be parsed, with their event and number of fields, in MessageType
+ * order from MESSAGE_CHA so that Message_Encode() can index it by type.  `isSigned` marks the
+ * templates whose fields are printed with %d rather than %u.
+ */
+static const struct {
+    uint32_t tag;
+    BB_EventType event;
+    uint8_t fields;
+    uint8_t isSigned;
+} messageFormats[] = {
+    {MESSAGE_TAG('C', 'H', 'A'), BB_EVENT_CHA_RECEIVED, 1, FALSE},
+    {MESSAGE_TAG('A', 'C', 'C'), BB_EVENT_ACC_RECEIVED, 1, FALSE},
+    {MESSAGE_TAG('R', 'E', 'V'), BB_EVENT_REV_RECEIVED, 1, FALSE},
+    {MESSAGE_TAG('S', 'H', 'O'), BB_EVENT_SHO_RECEIVED, 2, TRUE},
+    {MESSAGE_TAG('R', 'E', 'S'), BB_EVENT_RES_RECEIVED, 3, FALSE},
+    {MESSAGE_TAG('C', 'A', 'P'), BB_EVENT_CAP_RECEIVED, 2, FALSE},
+    {MESSAGE_TAG('R', 'A', 'S'), BB_EVENT_RAS_RECEIVED, 3, FALSE},
+};
+
+/**
+ * A perfect hash of the tags above: multiplying a packed tag by Knuth's constant and keeping the
+ * top three bits sends each one to its own slot, which holds its index in messageFormats (or
+ * MESSAGE_NO_FORMAT).  Any other tag lands on an empty slot or on a tag it does not match.  A new
+ * tag needs a free slot, or else a new multiplier or a bigger table.
+ */
+#define MESSAGE_HASH(tag) ((uint32_t) ((tag) * 2654435761u) >> 29)
+#define MESSAGE_NO_FORMAT 0xFF
+
+static const uint8_t messageFormatSlots[8] = {
+    2, // REV
+    4, // RES
+    6, // RAS
+    5, // CAP
+    0, // CHA
+    MESSAGE_NO_FORMAT,
+    1, // ACC
+    3, // SHO
+};
+
+/**
+ * Returns the index in messageFormats of a packed tag, or MESSAGE_NO_FORMAT.
+ */
+static uint8_t Message_FindFormat(uint32_t tag)
+{
+    uint8_t format = messageFormatSlots[MESSAGE_HASH(tag)];
+    if (format != MESSAGE_NO_FORMAT && messageFormats[format].tag == tag) {
+        return format;
+    }
+    return MESSAGE_NO_FORMAT;
+}
+
+/**
+ * What each character means to the decoder.  Looking the class up costs the same for every
+ * character, and the hex and decimal values follow from it with a subtraction.
+ */
+enum {
+    CHAR_OTHER,
+    CHAR_DIGIT,     // 0-9
+    CHAR_HEX,       // A-F
+    CHAR_START,     // $
+    CHAR_COMMA,     // ,
+    CHAR_CHECKSUM,  // *
+    CHAR_END,       // \n
+};
+
+static const uint8_t messageCharClass[256] = {
+    ['0' ... '9'] = CHAR_DIGIT,
+    ['A' ... 'F'] = CHAR_HEX,
+    ['$'] = CHAR_START,
+    [','] = CHAR_COMMA,
+    ['*'] = CHAR_CHECKSUM,
+    ['\n'] = CHAR_END,
+};
+
+/**
+ * Returns the value of an upper-case hex digit, or -1 if `c` is not one.
+ */
+static int Message_HexValue(char c)
+{
+    switch (messageCharClass[(uint8_t) c]) {
+    case CHAR_DIGIT:
+        return c - '0';
+    case CHAR_HEX:
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * Writes `value` in decimal at `out`, without a terminating '\0', XORs each digit into
+ * `checksum`, and returns the number of digits.  The digits come out least significant first,
+ * so they are staged in a buffer wide enough for any 32-bit value.
+ */
+static int Message_FormatDecimal(char *out, uint32_t value, uint8_t *checksum)
+{
+    char digits[10];
+    int length = 0, i;
+
+    do {
+        digits[length++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    for (i = 0; i < length; i++) {
+        out[i] = digits[length - 1 - i];
+        *checksum ^= out[i];
+    }
+    return length;
+}
+
+/**
+ * Flags an error in `event` and returns STANDARD_ERROR.
+ */
+static int Message_Error(BB_Event *event, BB_Error error)
+{
+    event->type = BB_EVENT_ERROR;
+    event->param0 = error;
+    event->param1 = 0;
+    event->param2 = 0;
+    return STANDARD_ERROR;
+}
+
+/**
+ * Given a payload string, calculate its checksum
+ *
+ * @param payload       //the string whose checksum we wish to calculate
+ * @return   //The resulting 8-bit checksum
+ */
+uint8_t Message_CalculateChecksum(const char* payload)
+{
+    uint8_t checksum = 0;
+    while (*payload) {
+        checksum ^= (uint8_t) *payload++;
+    }
+    return checksum;
+}
+
+/**
+ * ParseMessage() converts a message string into a BB_Event.  The payload and
+ * checksum of a message are passed into ParseMessage(), and it modifies a
+ * BB_Event struct in place to reflect the contents of the message.
+ *
+ * @param payload       //the payload of a message
+ * @param checksum      //the checksum (in string form) of  a message,
+ *                          should be exactly 2 chars long, plus a null char
+ * @param message_event //A BB_Event which will be modified by this function.
+ *                      //If the message could be parsed successfully,
+ *                          message_event's type will correspond to the message type and
+ *                          its parameters will match the message's data fields.
+ *                      //If the message could not be parsed,
+ *                          message_events type will be BB_EVENT_ERROR
+ *
+ * @return STANDARD_ERROR if:
+ *              the payload does not match the checksum
+ *              the checksum string is not two characters long
+ *              the message does not match any message template
+ *          SUCCESS otherwise
+ */
+int Message_ParseMessage(const char* payload,
+        const char* checksum_string, BB_Event * message_event)
+{
+    uint16_t params[3] = {0, 0, 0};
+    unsigned int i;
+    int field;
+
+    // The checksum must be exactly two upper-case hex digits that match the payload.
+    if (strlen(checksum_string) < MESSAGE_CHECKSUM_LEN) {
+        return Message_Error(message_event, BB_ERROR_CHECKSUM_LEN_INSUFFICIENT);
+    } else if (strlen(checksum_string) > MESSAGE_CHECKSUM_LEN) {
+        return Message_Error(message_event, BB_ERROR_CHECKSUM_LEN_EXCEEDED);
+    }
+    int high = Message_HexValue(checksum_string[0]);
+    int low = Message_HexValue(checksum_string[1]);
+    if (high < 0 || low < 0) {
+        return Message_Error(message_event, BB_ERROR_MESSAGE_PARSE_FAILURE);
+    }
+    if (Message_CalculateChecksum(payload) != ((high << 4) | low)) {
+        return Message_Error(message_event, BB_ERROR_BAD_CHECKSUM);
+    }
+    if (strlen(payload) > MESSAGE_MAX_PAYLOAD_LEN) {
+        return Message_Error(message_event, BB_ERROR_PAYLOAD_LEN_EXCEEDED);
+    }
+
+    i = MESSAGE_NO_FORMAT;
+    if (payload[0] && payload[1] && payload[2]) {
+        i = Message_FindFormat(MESSAGE_TAG(payload[0], payload[1], payload[2]));
+    }
+    if (i == MESSAGE_NO_FORMAT) {
+        return Message_Error(message_event, BB_ERROR_INVALID_MESSAGE_TYPE);
+    }
+
+    // Each field is a comma followed by one or more decimal digits.
+    const char *c = payload + 3;
+    for (field = 0; field < messageFormats[i].fields; field++) {
+        uint32_t value = 0;
+        if (*c++ != ',' || *c < '0' || *c > '9') {
+            return Message_Error(message_event, BB_ERROR_MESSAGE_PARSE_FAILURE);
+        }
+        while (*c >= '0' && *c <= '9') {
+            value = value * 10 + (*c++ - '0');
+            if (value > UINT16_MAX) {
+                return Message_Error(message_event, BB_ERROR_MESSAGE_PARSE_FAILURE);
+            }
+        }
+        params[field] = value;
+    }
+    if (*c != '\0') {
+        return Message_Error(message_event, BB_ERROR_MESSAGE_PARSE_FAILURE);
+    }
+
+    message_event->type = messageFormats[i].event;
+    message_event->param0 = params[0];
+    message_event->param1 = params[1];
+    message_event->param2 = params[2];
+    return SUCCESS;
+}
+
+/**
+ * Encodes the coordinate data for a guess into the string `message`. This string must be big
+ * enough to contain all of the necessary data. The format is specified in PAYLOAD_TEMPLATE_COO,
+ * which is then wrapped within the message as defined by MESSAGE_TEMPLATE.
+ *
+ * The final length of this
+ * message is then returned. There is no failure mode for this function as there is no checking
+ * for NULL pointers.
+ *
+ * @param message            The character array used for storing the output.
+ *                              Must be long enough to store the entire string,
+ *                              see MESSAGE_MAX_LEN.
+ * @param message_to_encode  A message to encode
+ * @return                   The length of the string stored into 'message_string'.
+                             Return 0 if message type is MESSAGE_NONE.
+ */
+int Message_Encode(char *message_string, Message message_to_encode)
+{
+    static const char hexDigits[] = "0123456789ABCDEF";
+    const unsigned int params[3] = {
+        message_to_encode.param0, message_to_encode.param1, message_to_encode.param2
+    };
+    char *out = message_string;
+    uint8_t checksum = 0;
+    int shift, field;
+
+    if (message_to_encode.type < MESSAGE_CHA || message_to_encode.type > MESSAGE_RAS) {
+        message_string[0] = '\0';
+        return 0;
+    }
+
+    // The payload is written once, XORed into the checksum as it goes, with the same bytes the
+    // PAYLOAD_TEMPLATE_* and MESSAGE_TEMPLATE formats would give sprintf().
+    uint8_t format = message_to_encode.type - MESSAGE_CHA;
+    *out++ = '$';
+    for (shift = 16; shift >= 0; shift -= 8) {
+        *out = messageFormats[format].tag >> shift;
+        checksum ^= *out++;
+    }
+    for (field = 0; field < messageFormats[format].fields; field++) {
+        uint32_t value = params[field];
+        *out++ = ',';
+        checksum ^= ',';
+        if (messageFormats[format].isSigned && (int) value < 0) {
+            *out++ = '-';
+            checksum ^= '-';
+            value = -value;
+        }
+        out += Message_FormatDecimal(out, value, &checksum);
+    }
+    *out++ = '*';
+    *out++ = hexDigits[checksum >> 4];
+    *out++ = hexDigits[checksum & 0xF];
+    *out++ = '\n';
+    *out = '\0';
+    return out - message_string;
+}
+
+/**
+ * Message_Decode reads one character at a time.  If it detects a full NMEA message,
+ * it translates that message into a BB_Event struct, which can be passed to other
+ * services.
+ *
+ * @param char_in - The next character in the NMEA0183 message to be decoded.
+ * @param decoded_message - a pointer to a message struct, used to "return" a message
+ *                          if char_in is the last character of a valid message,
+ *                              then decoded_message
+ *                              should have the appropriate message type.
+ *                          if char_in is the last character of an invalid message,
+ *                              then decoded_message should have an ERROR type.
+ *                          otherwise, it should have type NO_EVENT.
+ * @return SUCCESS if no error was detected
+ *         STANDARD_ERROR if an error was detected
+ *
+ * note that ANY call to Message_Decode may modify decoded_message.
+ */
+int Message_Decode(unsigned char char_in, BB_Event * decoded_message_event)
+{
+    return Message_DecodeWith(&defaultDecoder, char_in, decoded_message_event);
+}
+
+void Message_DecoderInit(MessageDecoder *decoder)
+{
+    decoder->state = WAITING_FOR_START_DELIMITER;
+}
+
+/**
+ * Notes the first error found in the payload.  It is reported at the end delimiter, after the
+ * checksum, which takes precedence as it does in Message_ParseMessage().
  */
-int main(int argc, char** argv) {
+static void Message_PayloadError(MessageDecoder *decoder, BB_Error error)
+{
+    if (decoder->error == BB_SUCCESS) {
+        decoder->error = error;
+    }
+}
 
-    return (EXIT_SUCCESS);
+/**
+ * Returns the XOR of `length` bytes.  With SSE2 (every x86-64 host) whole 16-byte blocks are
+ * XORed at once; a payload is too short for wider vectors to help.
+ */
+static uint8_t Message_XorBytes(const uint8_t *bytes, size_t length)
+{
+    uint8_t checksum = 0;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    if (length >= 16) {
+        __m128i blocks = _mm_setzero_si128();
+        for (; i + 16 <= length; i += 16) {
+            blocks = _mm_xor_si128(blocks, _mm_loadu_si128((const __m128i *) (bytes + i)));
+        }
+        blocks = _mm_xor_si128(blocks, _mm_srli_si128(blocks, 8));
+        blocks = _mm_xor_si128(blocks, _mm_srli_si128(blocks, 4));
+        blocks = _mm_xor_si128(blocks, _mm_srli_si128(blocks, 2));
+        blocks = _mm_xor_si128(blocks, _mm_srli_si128(blocks, 1));
+        checksum = _mm_cvtsi128_si32(blocks);
+    }
+#endif
+    for (; i < length; i++) {
+        checksum ^= bytes[i];
+    }
+    return checksum;
 }
 
+/**
+ * Returns the offset of the first '$', '*' or '\n' in `length` bytes, or `length` if there is
+ * none.  Hosts compare 32 (AVX2) or 16 (SSE2) bytes at a time; the PIC32 looks up each byte's
+ * class.
+ */
+static size_t Message_FindDelimiter(const uint8_t *bytes, size_t length)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i start = _mm256_set1_epi8('$');
+    const __m256i checksum = _mm256_set1_epi8('*');
+    const __m256i end = _mm256_set1_epi8('\n');
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (bytes + i));
+        uint32_t found = _mm256_movemask_epi8(_mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, start),
+                _mm256_cmpeq_epi8(block, checksum)), _mm256_cmpeq_epi8(block, end)));
+        if (found) {
+            return i + __builtin_ctz(found);
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i start = _mm_set1_epi8('$');
+    const __m128i checksum = _mm_set1_epi8('*');
+    const __m128i end = _mm_set1_epi8('\n');
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (bytes + i));
+        uint32_t found = _mm_movemask_epi8(_mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, start), _mm_cmpeq_epi8(block, checksum)),
+                _mm_cmpeq_epi8(block, end)));
+        if (found) {
+            return i + __builtin_ctz(found);
+        }
+    }
+#endif
+    for (; i < length; i++) {
+        uint8_t class = messageCharClass[bytes[i]];
+        if (class == CHAR_START || class == CHAR_CHECKSUM || class == CHAR_END) {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * Takes `length` payload characters, none of them a delimiter, that fit within
+ * MESSAGE_MAX_PAYLOAD_LEN: XORs them into the checksum, packs the tag and converts the fields.
+ * After the first error the rest only count toward the checksum.
+ */
+static void Message_DecodePayload(MessageDecoder *decoder, const uint8_t *payload, size_t length)
+{
+    uint8_t position = decoder->payloadLen;
+    size_t i;
+
+    decoder->payloadLen += length;
+    decoder->checksum ^= Message_XorBytes(payload, length);
+    for (i = 0; i < length && decoder->error == BB_SUCCESS; i++, position++) {
+        uint8_t c = payload[i], class = messageCharClass[c];
+        if (decoder->state == RECORDING_TAG) {
+            decoder->tag = (decoder->tag << 8) | c;
+            if (position == 2) {
+                decoder->format = Message_FindFormat(decoder->tag);
+                if (decoder->format == MESSAGE_NO_FORMAT) {
+                    Message_PayloadError(decoder, BB_ERROR_INVALID_MESSAGE_TYPE);
+                }
+                decoder->state = RECORDING_FIELDS;
+            }
+        } else if (class == CHAR_DIGIT && decoder->fields > 0) {
+            // Each field is a comma followed by one or more decimal digits.
+            decoder->value = decoder->value * 10 + (c - '0');
+            decoder->digits = 1;
+            if (decoder->value > UINT16_MAX) {
+                Message_PayloadError(decoder, BB_ERROR_MESSAGE_PARSE_FAILURE);
+            }
+        } else if (class == CHAR_COMMA &&
+                (decoder->fields == 0 || decoder->digits) &&
+                decoder->fields < messageFormats[decoder->format].fields) {
+            if (decoder->fields > 0) {
+                decoder->params[decoder->fields - 1] = decoder->value;
+            }
+            decoder->fields++;
+            decoder->digits = 0;
+            decoder->value = 0;
+        } else {
+            Message_PayloadError(decoder, BB_ERROR_MESSAGE_PARSE_FAILURE);
+        }
+    }
+}
+
+/**
+ * Nothing is buffered: the checksum is XORed together, the tag packed and the fields converted
+ * as their characters arrive, so every character costs a table lookup and a few operations.
+ */
+int Message_DecodeWith(MessageDecoder *decoder, unsigned char char_in,
+        BB_Event * decoded_message_event)
+{
+    uint8_t class = messageCharClass[char_in];
+
+    decoded_message_event->type = BB_EVENT_NO_EVENT;
+
+    switch (decoder->state) {
+        case WAITING_FOR_START_DELIMITER:
+            if (class == CHAR_START) {
+                decoder->payloadLen = 0;
+                decoder->checksum = 0;
+                decoder->checksumLen = 0;
+                decoder->received = 0;
+                decoder->tag = 0;
+                decoder->fields = 0;
+                decoder->digits = 0;
+                decoder->value = 0;
+                decoder->error = BB_SUCCESS;
+                decoder->state = RECORDING_TAG;
+            }
+            return SUCCESS;
+
+        case RECORDING_TAG:
+        case RECORDING_FIELDS:
+            if (class == CHAR_START || class == CHAR_END) {
+                decoder->state = WAITING_FOR_START_DELIMITER;
+                return Message_Error(decoded_message_event, BB_ERROR_MESSAGE_PARSE_FAILURE);
+            } else if (class == CHAR_CHECKSUM) {
+                if (decoder->state == RECORDING_TAG) {
+                    Message_PayloadError(decoder, BB_ERROR_INVALID_MESSAGE_TYPE);
+                } else if (decoder->digits == 0 ||
+                        decoder->fields != messageFormats[decoder->format].fields) {
+                    Message_PayloadError(decoder, BB_ERROR_MESSAGE_PARSE_FAILURE);
+                } else {
+                    decoder->params[decoder->fields - 1] = decoder->value;
+                }
+                decoder->state = RECORDING_CHECKSUM;
+                return SUCCESS;
+            } else if (decoder->payloadLen == MESSAGE_MAX_PAYLOAD_LEN) {
+                decoder->state = WAITING_FOR_START_DELIMITER;
+                return Message_Error(decoded_message_event, BB_ERROR_PAYLOAD_LEN_EXCEEDED);
+            }
+            Message_DecodePayload(decoder, &char_in, 1);
+            return SUCCESS;
+
+        case RECORDING_CHECKSUM:
+            if (class == CHAR_END) {
+                decoder->state = WAITING_FOR_START_DELIMITER;
+                if (decoder->checksumLen < MESSAGE_CHECKSUM_LEN) {
+                    return Message_Error(decoded_message_event, BB_ERROR_CHECKSUM_LEN_INSUFFICIENT);
+                } else if (decoder->received != decoder->checksum) {
+                    return Message_Error(decoded_message_event, BB_ERROR_BAD_CHECKSUM);
+                } else if (decoder->error != BB_SUCCESS) {
+                    return Message_Error(decoded_message_event, decoder->error);
+                }
+                decoded_message_event->type = messageFormats[decoder->format].event;
+                decoded_message_event->param0 = decoder->params[0];
+                decoded_message_event->param1 = decoder->fields > 1 ? decoder->params[1] : 0;
+                decoded_message_event->param2 = decoder->fields > 2 ? decoder->params[2] : 0;
+                return SUCCESS;
+            } else if (class != CHAR_DIGIT && class != CHAR_HEX) {
+                decoder->state = WAITING_FOR_START_DELIMITER;
+                return Message_Error(decoded_message_event, BB_ERROR_MESSAGE_PARSE_FAILURE);
+            } else if (decoder->checksumLen == MESSAGE_CHECKSUM_LEN) {
+                decoder->state = WAITING_FOR_START_DELIMITER;
+                return Message_Error(decoded_message_event, BB_ERROR_CHECKSUM_LEN_EXCEEDED);
+            }
+            decoder->received = (decoder->received << 4) | Message_HexValue(char_in);
+            decoder->checksumLen++;
+            return SUCCESS;
+    }
+    return SUCCESS;
+}
+
+size_t Message_DecodeBuffer(const uint8_t *buf, size_t len, BB_Event *out, size_t max_out,
+        size_t *consumed)
+{
+    return Message_DecodeBufferWith(&defaultDecoder, buf, len, out, max_out, consumed);
+}
+
+/**
+ * Between delimiters the bytes are either skipped, while waiting for a '$', or taken as one run
+ * of payload by Message_DecodePayload().  The delimiters themselves, the checksum digits and a
+ * payload that grows too long go through Message_DecodeWith(), so both give the same events.
+ */
+size_t Message_DecodeBufferWith(MessageDecoder *decoder, const uint8_t *buf, size_t len,
+        BB_Event *out, size_t max_out, size_t *consumed)
+{
+    size_t pos = 0, events = 0;
+
+    while (pos < len && events < max_out) {
+        if (decoder->state != RECORDING_CHECKSUM) {
+            size_t run = Message_FindDelimiter(buf + pos, len - pos);
+            if (decoder->state != WAITING_FOR_START_DELIMITER) {
+                // Anything past the longest payload is left for Message_DecodeWith() to reject.
+                size_t room = (size_t) (MESSAGE_MAX_PAYLOAD_LEN - decoder->payloadLen);
+                if (run > room) {
+                    run = room;
+                }
+                Message_DecodePayload(decoder, buf + pos, run);
+            }
+            pos += run;
+            if (pos == len) {
+                break;
+            }
+        }
+        Message_DecodeWith(decoder, buf[pos++], &out[events]);
+        if (out[events].type != BB_EVENT_NO_EVENT) {
+            events++;
+        }
+    }
+    if (consumed) {
+        *consumed = pos;
+    }
+    return events;
+}
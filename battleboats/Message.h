@@ -1,6 +1,7 @@
 #ifndef MESSAGE_H
 #define MESSAGE_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "BattleBoats.h"
 
@@ -31,6 +32,8 @@ typedef enum {
     MESSAGE_REV,
     MESSAGE_SHO,
     MESSAGE_RES,
+    MESSAGE_CAP,
+    MESSAGE_RAS,
             
     //while not required, an error message can be a useful debugging tool:
     MESSAGE_ERROR = -1, 
@@ -61,6 +64,8 @@ typedef struct {
 #define PAYLOAD_TEMPLATE_REV "REV,%u"       // Reveal message: 			A (see protocol)
 #define PAYLOAD_TEMPLATE_SHO "SHO,%d,%d"    // Shot (guess) message: 	row, col
 #define PAYLOAD_TEMPLATE_RES "RES,%u,%u,%u" // Result message: 			row, col, GuessResult
+#define PAYLOAD_TEMPLATE_CAP "CAP,%u,%u"    // Capability message:      capabilities, offer/answer
+#define PAYLOAD_TEMPLATE_RAS "RAS,%u,%u,%u" // Result and shot message: GuessResult, row, col
 
 
 /** 
@@ -165,5 +170,60 @@ int Message_Encode(char *message_string, Message message_to_encode);
  */
 int Message_Decode(unsigned char char_in, BB_Event * decoded_message_event);
 
+/**
+ * The state Message_Decode() keeps between characters. Message_Decode() uses one shared
+ * instance; code that decodes several streams at once (e.g. simulated games on many threads)
+ * gives each stream its own and calls Message_DecodeWith().
+ */
+typedef struct {
+    uint8_t state;
+    uint8_t payloadLen;  // Payload characters so far.
+    uint8_t checksum;    // Their XOR.
+    uint8_t checksumLen; // Checksum digits so far.
+    uint8_t received;    // Their value.
+    uint8_t format;      // The message type, once the tag is complete.
+    uint8_t fields;      // Fields started so far.
+    uint8_t digits;      // Whether the current field has any digits yet.
+    uint8_t error;       // The first BB_Error in the payload, or BB_SUCCESS.
+    uint32_t tag;        // The tag's characters, packed.
+    uint32_t value;      // The current field's value so far.
+    uint16_t params[3];  // The fields already complete.
+} MessageDecoder;
+
+/**
+ * Prepares `decoder` to wait for the start of a message.
+ */
+void Message_DecoderInit(MessageDecoder *decoder);
+
+/**
+ * Message_Decode(), with the decoding state held in `decoder`.
+ */
+int Message_DecodeWith(MessageDecoder *decoder, unsigned char char_in,
+        BB_Event * decoded_message_event);
+
+/**
+ * Decodes a whole buffer of received bytes at once, giving the same events, in the same order, as
+ * passing each byte to Message_Decode().  Messages may be split between calls.  On hosts the
+ * delimiters are found 16 or 32 bytes at a time and each payload is checksummed as one span, for
+ * simulations and logs that push a great deal of traffic through the decoder.
+ * @param buf       The bytes to decode.
+ * @param len       How many there are.
+ * @param out       Where to store the events, other than BB_EVENT_NO_EVENT, that they produce.
+ * @param max_out   How many events `out` has room for.  Decoding stops after the byte that
+ *                      produces the last of them.  No byte produces more than one event, so
+ *                      with room for `len` events the whole buffer is always decoded.
+ * @param consumed  If not NULL, set to how many bytes were decoded; the rest must be passed
+ *                      again.
+ * @return The number of events stored in `out`.
+ */
+size_t Message_DecodeBuffer(const uint8_t *buf, size_t len, BB_Event *out, size_t max_out,
+        size_t *consumed);
+
+/**
+ * Message_DecodeBuffer(), with the decoding state held in `decoder`.
+ */
+size_t Message_DecodeBufferWith(MessageDecoder *decoder, const uint8_t *buf, size_t len,
+        BB_Event *out, size_t max_out, size_t *consumed);
+
 
 #endif // MESSAGE_H
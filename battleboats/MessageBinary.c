@@ -0,0 +1,229 @@
+/*
+ * File:   MessageBinary.c
+ *
+ * Binary message frames: packed fields, a CRC-8 and COBS framing.  See MessageBinary.h.
+ */
+
+#include "MessageBinary.h"
+#include "BOARD.h"
+
+static MessageBinaryDecoder defaultBinaryDecoder;
+
+/**
+ * The CRC-8 of each byte value, for polynomial 0x07: one lookup per byte instead of eight shifts.
+ */
+static const uint8_t crc8Table[256] = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31,
+    0x24, 0x23, 0x2A, 0x2D, 0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65,
+    0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D, 0xE0, 0xE7, 0xEE, 0xE9,
+    0xFC, 0xFB, 0xF2, 0xF5, 0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
+    0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85, 0xA8, 0xAF, 0xA6, 0xA1,
+    0xB4, 0xB3, 0xBA, 0xBD, 0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2,
+    0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA, 0xB7, 0xB0, 0xB9, 0xBE,
+    0xAB, 0xAC, 0xA5, 0xA2, 0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
+    0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32, 0x1F, 0x18, 0x11, 0x16,
+    0x03, 0x04, 0x0D, 0x0A, 0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42,
+    0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A, 0x89, 0x8E, 0x87, 0x80,
+    0x95, 0x92, 0x9B, 0x9C, 0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
+    0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC, 0xC1, 0xC6, 0xCF, 0xC8,
+    0xDD, 0xDA, 0xD3, 0xD4, 0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C,
+    0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44, 0x19, 0x1E, 0x17, 0x10,
+    0x05, 0x02, 0x0B, 0x0C, 0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
+    0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B, 0x76, 0x71, 0x78, 0x7F,
+    0x6A, 0x6D, 0x64, 0x63, 0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B,
+    0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13, 0xAE, 0xA9, 0xA0, 0xA7,
+    0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
+    0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF,
+    0xFA, 0xFD, 0xF4, 0xF3,
+};
+
+/**
+ * The event and frame length, type and CRC included, of each message type, in MessageType order
+ * from MESSAGE_CHA.  CAP messages are always text, so they have no frame.
+ */
+static const struct {
+    BB_EventType event;
+    uint8_t length;
+} binaryFormats[] = {
+    {BB_EVENT_CHA_RECEIVED, 4},
+    {BB_EVENT_ACC_RECEIVED, 4},
+    {BB_EVENT_REV_RECEIVED, 4},
+    {BB_EVENT_SHO_RECEIVED, 3},
+    {BB_EVENT_RES_RECEIVED, 4},
+    {BB_EVENT_NO_EVENT, 0},
+    {BB_EVENT_RAS_RECEIVED, 4},
+};
+
+#define BINARY_NUM_FORMATS (sizeof (binaryFormats) / sizeof (binaryFormats[0]))
+
+uint8_t MessageBinary_Crc8(const uint8_t *data, uint8_t length)
+{
+    uint8_t crc = 0;
+    while (length--) {
+        crc = crc8Table[crc ^ *data++];
+    }
+    return crc;
+}
+
+int MessageBinary_Encode(uint8_t *frame, Message message_to_encode)
+{
+    uint8_t raw[MESSAGE_BINARY_MAX_FRAME];
+    uint8_t length, i, *code;
+    int out;
+
+    if (message_to_encode.type < MESSAGE_CHA ||
+            message_to_encode.type >= MESSAGE_CHA + (int) BINARY_NUM_FORMATS) {
+        return 0;
+    }
+    length = binaryFormats[message_to_encode.type - MESSAGE_CHA].length;
+    if (length == 0) {
+        return 0;
+    }
+    raw[0] = message_to_encode.type;
+    switch (message_to_encode.type) {
+    case MESSAGE_SHO:
+    case MESSAGE_RES:
+        if (message_to_encode.param0 > 0xF || message_to_encode.param1 > 0xF) {
+            return 0;
+        }
+        raw[1] = (message_to_encode.param0 << 4) | message_to_encode.param1;
+        raw[2] = message_to_encode.param2;
+        break;
+    case MESSAGE_RAS:
+        if (message_to_encode.param1 > 0xF || message_to_encode.param2 > 0xF) {
+            return 0;
+        }
+        raw[1] = message_to_encode.param0;
+        raw[2] = (message_to_encode.param1 << 4) | message_to_encode.param2;
+        break;
+    default:
+        raw[1] = message_to_encode.param0 >> 8;
+        raw[2] = message_to_encode.param0;
+        break;
+    }
+    raw[length - 1] = MessageBinary_Crc8(raw, length - 1);
+
+    // COBS: each zero is replaced by a code byte ahead of the run before it, holding the distance
+    // to it; the first code byte stands for a zero just past the end.  Frames are far shorter
+    // than the 254 bytes a code can cover.
+    code = frame;
+    out = 1;
+    for (i = 0; i < length; i++) {
+        if (raw[i] == 0) {
+            *code = &frame[out] - code;
+            code = &frame[out++];
+        } else {
+            frame[out++] = raw[i];
+        }
+    }
+    *code = &frame[out] - code;
+    frame[out++] = MESSAGE_BINARY_DELIMITER;
+    return out;
+}
+
+void MessageBinary_DecoderInit(MessageBinaryDecoder *decoder)
+{
+    decoder->length = 0;
+    decoder->blockLeft = 0;
+    decoder->zeroPending = FALSE;
+    decoder->overflow = FALSE;
+}
+
+/**
+ * Turns the frame in `decoder` into an event, and returns the BB_Error it has, if any.
+ */
+static BB_Error MessageBinary_Parse(const MessageBinaryDecoder *decoder, BB_Event *event)
+{
+    const uint8_t *frame = decoder->frame;
+    uint8_t format = frame[0] - MESSAGE_CHA;
+
+    if (decoder->overflow) {
+        return BB_ERROR_PAYLOAD_LEN_EXCEEDED;
+    }
+    if (decoder->blockLeft != 0 || decoder->length < 2) {
+        return BB_ERROR_MESSAGE_PARSE_FAILURE;
+    }
+    if (MessageBinary_Crc8(frame, decoder->length) != 0) {
+        return BB_ERROR_BAD_CHECKSUM;
+    }
+    if (format >= BINARY_NUM_FORMATS || binaryFormats[format].length == 0) {
+        return BB_ERROR_INVALID_MESSAGE_TYPE;
+    }
+    if (decoder->length != binaryFormats[format].length) {
+        return BB_ERROR_MESSAGE_PARSE_FAILURE;
+    }
+    event->type = binaryFormats[format].event;
+    switch (frame[0]) {
+    case MESSAGE_SHO:
+    case MESSAGE_RES:
+        event->param0 = frame[1] >> 4;
+        event->param1 = frame[1] & 0xF;
+        event->param2 = (frame[0] == MESSAGE_RES) ? frame[2] : 0;
+        break;
+    case MESSAGE_RAS:
+        event->param0 = frame[1];
+        event->param1 = frame[2] >> 4;
+        event->param2 = frame[2] & 0xF;
+        break;
+    default:
+        event->param0 = ((uint16_t) frame[1] << 8) | frame[2];
+        event->param1 = 0;
+        event->param2 = 0;
+        break;
+    }
+    return BB_SUCCESS;
+}
+
+int MessageBinary_Decode(uint8_t byte_in, BB_Event *decoded_message_event)
+{
+    return MessageBinary_DecodeWith(&defaultBinaryDecoder, byte_in, decoded_message_event);
+}
+
+int MessageBinary_DecodeWith(MessageBinaryDecoder *decoder, uint8_t byte_in,
+        BB_Event *decoded_message_event)
+{
+    BB_Error error;
+
+    decoded_message_event->type = BB_EVENT_NO_EVENT;
+    decoded_message_event->param0 = 0;
+    decoded_message_event->param1 = 0;
+    decoded_message_event->param2 = 0;
+
+    if (byte_in == MESSAGE_BINARY_DELIMITER) {
+        // A delimiter on its own, e.g. after a frame that was cut short, ends nothing.
+        if (decoder->length == 0 && decoder->blockLeft == 0 && !decoder->overflow) {
+            return SUCCESS;
+        }
+        error = MessageBinary_Parse(decoder, decoded_message_event);
+        MessageBinary_DecoderInit(decoder);
+        if (error != BB_SUCCESS) {
+            decoded_message_event->type = BB_EVENT_ERROR;
+            decoded_message_event->param0 = error;
+            decoded_message_event->param1 = 0;
+            decoded_message_event->param2 = 0;
+            return STANDARD_ERROR;
+        }
+        return SUCCESS;
+    }
+
+    if (decoder->blockLeft == 0) {
+        // A code byte: the zero the last one stood for, if any, then a block of byte_in - 1.
+        if (decoder->zeroPending) {
+            if (decoder->length == MESSAGE_BINARY_MAX_FRAME) {
+                decoder->overflow = TRUE;
+            } else {
+                decoder->frame[decoder->length++] = 0;
+            }
+        }
+        decoder->zeroPending = (byte_in != 0xFF);
+        decoder->blockLeft = byte_in - 1;
+    } else {
+        decoder->blockLeft--;
+        if (decoder->length == MESSAGE_BINARY_MAX_FRAME) {
+            decoder->overflow = TRUE;
+        } else {
+            decoder->frame[decoder->length++] = byte_in;
+        }
+    }
+    return SUCCESS;
+}
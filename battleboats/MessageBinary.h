@@ -0,0 +1,91 @@
+#ifndef MESSAGE_BINARY_H
+#define MESSAGE_BINARY_H
+
+#include <stdint.h>
+#include "BattleBoats.h"
+#include "Message.h"
+
+/**
+ * Binary frames carry the same messages as the `$PAYLOAD*CHECKSUM\n` text of Message.h in under
+ * half the bytes.  Both boards switch to them once a CAP exchange agrees on
+ * CAPABILITY_BINARY_FRAMES (see Capability.h); CAP messages themselves are always text, so they
+ * have no frame.
+ *
+ * A frame is the message type, its fields packed into as few bytes as they need, and a CRC-8 of
+ * both, COBS-encoded so that it contains no zero bytes, then a zero byte to end it:
+ *
+ *     type  CHA, ACC, REV: value (16 bits, high byte first)
+ *           SHO:           row << 4 | col
+ *           RES:           row << 4 | col, result
+ *           RAS:           result, row << 4 | col
+ *     CRC-8 (polynomial 0x07, initial value 0) of the type and fields
+ *
+ * For example $RES,3,7,1*XX\n, 14 bytes as text, is the 4 bytes 05 37 01 CRC before COBS and 6
+ * bytes on the wire.  A receiver that loses its place, or starts listening mid-frame, picks up
+ * again at the next zero byte.  The frame it lost decodes as an error, which the Link submodule
+ * of Lab09_main.c drops; both boards then return to text and send their last message again.
+ */
+
+/**
+ * The longest frame before COBS (a CHA, ACC, REV or RES: type, two bytes of fields and the CRC),
+ * and the longest on the wire, with the COBS code byte and the zero byte that ends it.
+ */
+#define MESSAGE_BINARY_MAX_FRAME 4
+#define MESSAGE_BINARY_MAX_LEN (MESSAGE_BINARY_MAX_FRAME + 2)
+
+/**
+ * The byte that ends every frame, and the only place a zero byte appears.
+ */
+#define MESSAGE_BINARY_DELIMITER 0x00
+
+/**
+ * Returns the CRC-8 of `length` bytes of `data`, with polynomial 0x07 and initial value 0.  The
+ * CRC of a frame followed by its own CRC is 0.
+ */
+uint8_t MessageBinary_Crc8(const uint8_t *data, uint8_t length);
+
+/**
+ * Encodes `message_to_encode` as a binary frame, delimiter included, into `frame`, which must
+ * have room for MESSAGE_BINARY_MAX_LEN bytes.
+ *
+ * @return The length of the frame, or 0 if the message type is MESSAGE_NONE, MESSAGE_CAP or
+ *         unknown, or a SHO, RES or RAS row or column does not fit in four bits.
+ */
+int MessageBinary_Encode(uint8_t *frame, Message message_to_encode);
+
+/**
+ * The state MessageBinary_Decode() keeps between bytes: the frame so far, with its COBS encoding
+ * already undone.
+ */
+typedef struct {
+    uint8_t length;                          // Frame bytes so far.
+    uint8_t blockLeft;                       // Bytes left in the current COBS block.
+    uint8_t zeroPending;                     // Whether a zero follows the current COBS block.
+    uint8_t overflow;                        // Whether the frame is too long to be a message.
+    uint8_t frame[MESSAGE_BINARY_MAX_FRAME];
+} MessageBinaryDecoder;
+
+/**
+ * Prepares `decoder` for the start of a frame.
+ */
+void MessageBinary_DecoderInit(MessageBinaryDecoder *decoder);
+
+/**
+ * Reads one byte of binary frames, as Message_Decode() reads text.  At each delimiter,
+ * `decoded_message_event` gets the frame's message, or BB_EVENT_ERROR with a BB_Error in param0
+ * if its CRC does not match (BB_ERROR_BAD_CHECKSUM), its type is unknown or CAP
+ * (BB_ERROR_INVALID_MESSAGE_TYPE), it is too long (BB_ERROR_PAYLOAD_LEN_EXCEEDED), or it is the
+ * wrong length for its type or not valid COBS (BB_ERROR_MESSAGE_PARSE_FAILURE).  An empty frame,
+ * a delimiter on its own, is ignored.  Otherwise it gets BB_EVENT_NO_EVENT.
+ *
+ * @return SUCCESS if no error was detected, STANDARD_ERROR if one was.
+ */
+int MessageBinary_Decode(uint8_t byte_in, BB_Event *decoded_message_event);
+
+/**
+ * MessageBinary_Decode(), with the decoding state held in `decoder`.
+ */
+int MessageBinary_DecodeWith(MessageBinaryDecoder *decoder, uint8_t byte_in,
+        BB_Event *decoded_message_event);
+
+#endif // MESSAGE_BINARY_H
@@ -0,0 +1,187 @@
+/*
+ * File:   MessageBinaryTest.c
+ *
+ * Tests for the binary message frames in MessageBinary.c.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BOARD.h"
+#include "Message.h"
+#include "MessageBinary.h"
+
+/**
+ * Decodes `length` bytes with `decoder`, and returns how many events other than
+ * BB_EVENT_NO_EVENT they produced, storing the last of them in `last`.
+ */
+static int DecodeAll(MessageBinaryDecoder *decoder, const uint8_t *bytes, int length,
+        BB_Event *last)
+{
+    BB_Event event;
+    int i, events = 0;
+    for (i = 0; i < length; i++) {
+        MessageBinary_DecodeWith(decoder, bytes[i], &event);
+        if (event.type != BB_EVENT_NO_EVENT) {
+            *last = event;
+            events++;
+        }
+    }
+    return events;
+}
+
+int main(int argc, char** argv) {
+    BOARD_Init();
+    int resCount = 0;
+    int i, length;
+    uint8_t frame[MESSAGE_BINARY_MAX_LEN];
+    char text[MESSAGE_MAX_LEN + 1];
+    MessageBinaryDecoder decoder;
+    BB_Event event;
+    printf("Welcome to the MessageBinary.c Test!\n");
+
+    printf("Now Testing MessageBinary_Crc8()\n");
+    // The standard check value for CRC-8 with polynomial 0x07.
+    if (MessageBinary_Crc8((const uint8_t *) "123456789", 9) == 0xF4) {
+        resCount++;
+    }
+    uint8_t checked[] = {0x05, 0x37, 0x01, 0x55};
+    if (MessageBinary_Crc8(checked, 3) == 0x55 && MessageBinary_Crc8(checked, 4) == 0) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing MessageBinary_Encode()\n");
+    Message res = {MESSAGE_RES, 3, 7, 1};
+    length = MessageBinary_Encode(frame, res);
+    if (length == 6 && memcmp(frame, "\x05\x05\x37\x01\x55\x00", 6) == 0) {
+        resCount++;
+    }
+    // Zero bytes inside the frame become COBS code bytes.
+    Message cha = {MESSAGE_CHA, 0x0100, 0, 0};
+    length = MessageBinary_Encode(frame, cha);
+    if (length == 6 && memcmp(frame, "\x03\x01\x01\x02\x7E\x00", 6) == 0) {
+        resCount++;
+    }
+    // CAP messages are always text, so they have no frame.
+    Message offBoard = {MESSAGE_SHO, 16, 2, 0};
+    Message none = {MESSAGE_NONE, 0, 0, 0};
+    Message cap = {MESSAGE_CAP, 15, 1, 0};
+    if (MessageBinary_Encode(frame, offBoard) == 0 && MessageBinary_Encode(frame, none) == 0 &&
+            MessageBinary_Encode(frame, cap) == 0) {
+        resCount++;
+    }
+    // Every message sent as a binary frame takes less than half the bytes it does as text.
+    Message samples[] = {
+        {MESSAGE_CHA, 43182, 0, 0}, {MESSAGE_ACC, 57203, 0, 0}, {MESSAGE_REV, 9034, 0, 0},
+        {MESSAGE_SHO, 0, 9, 0}, {MESSAGE_RES, 5, 2, 3}, {MESSAGE_RAS, 1, 4, 6},
+    };
+    uint8_t shorter = TRUE;
+    for (i = 0; i < 6; i++) {
+        if (2 * MessageBinary_Encode(frame, samples[i]) >= Message_Encode(text, samples[i])) {
+            shorter = FALSE;
+        }
+    }
+    if (shorter) {
+        resCount++;
+    }
+    if (resCount == 4) {
+        printf("PASSED: 4/4 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/4 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing MessageBinary_Decode()\n");
+    // Every message type, over the whole range of each field, comes back as it went out.
+    static const BB_EventType events[] = {
+        BB_EVENT_CHA_RECEIVED, BB_EVENT_ACC_RECEIVED, BB_EVENT_REV_RECEIVED,
+        BB_EVENT_SHO_RECEIVED, BB_EVENT_RES_RECEIVED, BB_EVENT_RAS_RECEIVED,
+    };
+    uint8_t intact = TRUE;
+    for (i = 0; i < 6 * 256; i++) {
+        Message message = samples[i % 6];
+        uint16_t value = (i / 6) * 257;
+        uint16_t expected[3];
+        if (message.type == MESSAGE_SHO || message.type == MESSAGE_RES) {
+            message.param0 = (i / 6) >> 4;
+            message.param1 = (i / 6) & 0xF;
+            message.param2 = (message.type == MESSAGE_RES) ? value & 0xFF : 0;
+        } else if (message.type == MESSAGE_RAS) {
+            message.param0 = value & 0xFF;
+            message.param1 = (i / 6) >> 4;
+            message.param2 = (i / 6) & 0xF;
+        } else {
+            message.param0 = value;
+        }
+        expected[0] = message.param0;
+        expected[1] = message.param1;
+        expected[2] = message.param2;
+        length = MessageBinary_Encode(frame, message);
+        MessageBinary_DecoderInit(&decoder);
+        if (DecodeAll(&decoder, frame, length, &event) != 1 || event.type != events[i % 6] ||
+                event.param0 != expected[0] || event.param1 != expected[1] ||
+                event.param2 != expected[2]) {
+            intact = FALSE;
+        }
+    }
+    if (intact) {
+        resCount++;
+    }
+    // A damaged byte fails the CRC.
+    MessageBinary_DecoderInit(&decoder);
+    length = MessageBinary_Encode(frame, res);
+    frame[2] ^= 0x10;
+    if (DecodeAll(&decoder, frame, length, &event) == 1 && event.type == BB_EVENT_ERROR &&
+            event.param0 == BB_ERROR_BAD_CHECKSUM) {
+        resCount++;
+    }
+    // Joining mid-frame costs that frame, and only that frame; lone delimiters are ignored.
+    uint8_t stream[3 + 2 * MESSAGE_BINARY_MAX_LEN];
+    length = MessageBinary_Encode(frame, res);
+    memcpy(stream, frame + 2, length - 2); // the end of a frame, delimiter included
+    stream[length - 2] = MESSAGE_BINARY_DELIMITER;
+    memcpy(stream + length - 1, frame, length);
+    MessageBinary_DecoderInit(&decoder);
+    if (DecodeAll(&decoder, stream, length - 3, &event) == 0 &&
+            DecodeAll(&decoder, stream + length - 3, 1, &event) == 1 &&
+            event.type == BB_EVENT_ERROR &&
+            DecodeAll(&decoder, stream + length - 2, length + 1, &event) == 1 &&
+            event.type == BB_EVENT_RES_RECEIVED && event.param1 == 7) {
+        resCount++;
+    }
+    // So does text, or anything else too long to be a frame.
+    MessageBinary_DecoderInit(&decoder);
+    length = Message_Encode(text, res);
+    if (DecodeAll(&decoder, (const uint8_t *) text, length, &event) == 0 &&
+            MessageBinary_DecodeWith(&decoder, MESSAGE_BINARY_DELIMITER, &event) ==
+            STANDARD_ERROR && event.param0 == BB_ERROR_PAYLOAD_LEN_EXCEEDED) {
+        resCount++;
+    }
+    // A frame of the wrong length for its type, or of an unknown type, is rejected.
+    uint8_t shortCha[] = {0x01, 0x43}, unknownType[] = {0x09, 0x00};
+    uint8_t wire[8];
+    shortCha[1] = MessageBinary_Crc8(shortCha, 1);
+    unknownType[1] = MessageBinary_Crc8(unknownType, 1);
+    wire[0] = 3, wire[1] = shortCha[0], wire[2] = shortCha[1], wire[3] = 0;
+    wire[4] = 3, wire[5] = unknownType[0], wire[6] = unknownType[1], wire[7] = 0;
+    MessageBinary_DecoderInit(&decoder);
+    if (DecodeAll(&decoder, wire, 4, &event) == 1 &&
+            event.param0 == BB_ERROR_MESSAGE_PARSE_FAILURE &&
+            DecodeAll(&decoder, wire + 4, 4, &event) == 1 &&
+            event.param0 == BB_ERROR_INVALID_MESSAGE_TYPE) {
+        resCount++;
+    }
+    if (resCount == 5) {
+        printf("PASSED: 5/5 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/5 TESTS PASSED\n", resCount);
+    }
+
+    return (EXIT_SUCCESS);
+}
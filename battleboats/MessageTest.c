@@ -1,4 +1,4 @@
-/* 
+/*
  * File:   MessageTest.c
  * Author: ryryd
  *
@@ -7,12 +7,321 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "BOARD.h"
+#include "Message.h"
+
+/**
+ * Feeds a whole string to Message_Decode(), returning the last event it produced (or the first
+ * error).
+ */
+static BB_Event DecodeString(const char *s)
+{
+    BB_Event event = {BB_EVENT_NO_EVENT, 0, 0, 0};
+    BB_Event last = event;
+    while (*s) {
+        Message_Decode((unsigned char) *s++, &event);
+        if (event.type != BB_EVENT_NO_EVENT) {
+            last = event;
+        }
+    }
+    return last;
+}
+
+/**
+ * Formats `message` the way the PAYLOAD_TEMPLATE_* and MESSAGE_TEMPLATE formats specify, with
+ * sprintf(), for comparison with Message_Encode().
+ */
+static int EncodeWithTemplates(char *encoded, Message message)
+{
+    char payload[MESSAGE_MAX_PAYLOAD_LEN + 1];
+    switch (message.type) {
+    case MESSAGE_CHA:
+        sprintf(payload, PAYLOAD_TEMPLATE_CHA, message.param0);
+        break;
+    case MESSAGE_ACC:
+        sprintf(payload, PAYLOAD_TEMPLATE_ACC, message.param0);
+        break;
+    case MESSAGE_REV:
+        sprintf(payload, PAYLOAD_TEMPLATE_REV, message.param0);
+        break;
+    case MESSAGE_SHO:
+        sprintf(payload, PAYLOAD_TEMPLATE_SHO, message.param0, message.param1);
+        break;
+    case MESSAGE_RES:
+        sprintf(payload, PAYLOAD_TEMPLATE_RES, message.param0, message.param1, message.param2);
+        break;
+    case MESSAGE_CAP:
+        sprintf(payload, PAYLOAD_TEMPLATE_CAP, message.param0, message.param1);
+        break;
+    case MESSAGE_RAS:
+        sprintf(payload, PAYLOAD_TEMPLATE_RAS, message.param0, message.param1, message.param2);
+        break;
+    default:
+        encoded[0] = '\0';
+        return 0;
+    }
+    return sprintf(encoded, MESSAGE_TEMPLATE, payload, Message_CalculateChecksum(payload));
+}
 
 /*
- * 
+ *
  */
 int main(int argc, char** argv) {
+    BOARD_Init();
+    int resCount = 0;
+    int i;
+    char encoded[MESSAGE_MAX_LEN + 1];
+    BB_Event event;
+    printf("Welcome to the Message.c Test!\n");
+
+    printf("Now Testing Message_CalculateChecksum()\n");
+    if (Message_CalculateChecksum("SHO,2,9") == 0x5F) {
+        resCount++;
+    }
+    if (Message_CalculateChecksum("") == 0) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Message_Encode()\n");
+    Message sho = {MESSAGE_SHO, 2, 9, 0};
+    if (Message_Encode(encoded, sho) == 12 && strcmp(encoded, "$SHO,2,9*5F\n") == 0) {
+        resCount++;
+    }
+    Message res = {MESSAGE_RES, 4, 8, 1};
+    if (Message_Encode(encoded, res) == strlen(encoded) && strcmp(encoded, "$RES,4,8,1*55\n") == 0) {
+        resCount++;
+    }
+    Message cha = {MESSAGE_CHA, 43182, 0, 0};
+    if (Message_Encode(encoded, cha) > 0 && strcmp(encoded, "$CHA,43182*5A\n") == 0) {
+        resCount++;
+    }
+    Message none = {MESSAGE_NONE, 0, 0, 0};
+    if (Message_Encode(encoded, none) == 0) {
+        resCount++;
+    }
+    Message cap = {MESSAGE_CAP, 7, 1, 0};
+    if (Message_Encode(encoded, cap) > 0 && strcmp(encoded, "$CAP,7,1*54\n") == 0) {
+        resCount++;
+    }
+    if (resCount == 5) {
+        printf("PASSED: 5/5 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/5 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Message_Encode() against the templates\n");
+    // Every type, with values from 0 up to every digit count, and the extremes: SHO's %d fields
+    // print negative when their top bit is set.
+    static const unsigned int values[] = {
+        0, 9, 10, 99, 100, 65535, 65536, 999999999, 1000000000, 2147483647, 2147483648u,
+        UINT32_MAX
+    };
+    const int numValues = sizeof (values) / sizeof (values[0]);
+    char expected[MESSAGE_MAX_LEN + 1];
+    int matched = 0, cases = 0, type, v;
+    for (type = MESSAGE_NONE; type <= MESSAGE_RAS; type++) {
+        for (v = 0; v < numValues * numValues; v++) {
+            Message m = {type, values[v % numValues], values[v / numValues],
+                values[(v * 7) % numValues]};
+            int length = Message_Encode(encoded, m);
+            cases++;
+            if (length == EncodeWithTemplates(expected, m) && strcmp(encoded, expected) == 0) {
+                matched++;
+            }
+        }
+    }
+    if (matched == cases) {
+        resCount++;
+    }
+    // Random values, as a cross-check.
+    srand(22);
+    matched = cases = 0;
+    for (i = 0; i < 100000; i++) {
+        Message m = {MESSAGE_CHA + rand() % 6, rand() ^ (rand() << 16), rand() % 1000,
+            rand() % 100000};
+        int length = Message_Encode(encoded, m);
+        cases++;
+        if (length == EncodeWithTemplates(expected, m) && strcmp(encoded, expected) == 0) {
+            matched++;
+        }
+    }
+    if (matched == cases) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Message_ParseMessage()\n");
+    if (Message_ParseMessage("SHO,2,9", "5F", &event) == SUCCESS &&
+            event.type == BB_EVENT_SHO_RECEIVED && event.param0 == 2 && event.param1 == 9) {
+        resCount++;
+    }
+    if (Message_ParseMessage("SHO,2,9", "5E", &event) == STANDARD_ERROR &&
+            event.type == BB_EVENT_ERROR && event.param0 == BB_ERROR_BAD_CHECKSUM) {
+        resCount++;
+    }
+    if (Message_ParseMessage("SHO,2,9", "5", &event) == STANDARD_ERROR &&
+            event.param0 == BB_ERROR_CHECKSUM_LEN_INSUFFICIENT) {
+        resCount++;
+    }
+    if (Message_ParseMessage("SHO,2", "5F", &event) == STANDARD_ERROR) {
+        resCount++;
+    }
+    if (Message_ParseMessage("FOO,1", "5B", &event) == STANDARD_ERROR &&
+            event.param0 == BB_ERROR_INVALID_MESSAGE_TYPE) {
+        resCount++;
+    }
+    if (resCount == 5) {
+        printf("PASSED: 5/5 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/5 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Message_Decode()\n");
+    event = DecodeString("$SHO,2,9*5F\n");
+    if (event.type == BB_EVENT_SHO_RECEIVED && event.param0 == 2 && event.param1 == 9) {
+        resCount++;
+    }
+    event = DecodeString("noise$RES,4,8,1*55\n");
+    if (event.type == BB_EVENT_RES_RECEIVED && event.param0 == 4 && event.param1 == 8 &&
+            event.param2 == 1) {
+        resCount++;
+    }
+    event = DecodeString("$SHO,2,9*5f\n");
+    if (event.type == BB_EVENT_ERROR) {
+        resCount++; // Lower-case checksums are invalid.
+    }
+    event = DecodeString("$SHO,2,9*5F5\n");
+    if (event.type == BB_EVENT_ERROR && event.param0 == BB_ERROR_CHECKSUM_LEN_EXCEEDED) {
+        resCount++;
+    }
+    // A broken message must not stop the next one from decoding.
+    event = DecodeString("$SHO,2$ACC,57203*5E\n");
+    if (event.type == BB_EVENT_ERROR) {
+        resCount++;
+    }
+    event = DecodeString("$ACC,57203*5E\n");
+    if (event.type == BB_EVENT_ACC_RECEIVED && event.param0 == 57203) {
+        resCount++;
+    }
+    event = DecodeString("$CAP,7,0*55\n");
+    if (event.type == BB_EVENT_CAP_RECEIVED && event.param0 == 7 && event.param1 == 0) {
+        resCount++;
+    }
+    event = DecodeString("$REV,65535*5D\n$REV,65536*5E\n");
+    if (event.type == BB_EVENT_ERROR && event.param0 == BB_ERROR_MESSAGE_PARSE_FAILURE &&
+            DecodeString("$REV,65535*5D\n").param0 == 65535) {
+        resCount++;
+    }
+    // FOO hashes to RES's slot in the tag table.
+    event = DecodeString("$FOO,1*5B\n");
+    if (event.type == BB_EVENT_ERROR && event.param0 == BB_ERROR_INVALID_MESSAGE_TYPE) {
+        resCount++;
+    }
+    // A bad checksum is reported before anything wrong with the payload.
+    event = DecodeString("$SHO,1,2,3*49\n");
+    if (event.type == BB_EVENT_ERROR && event.param0 == BB_ERROR_BAD_CHECKSUM &&
+            DecodeString("$SHO,1,2,3*48\n").param0 == BB_ERROR_MESSAGE_PARSE_FAILURE) {
+        resCount++;
+    }
+    if (resCount == 10) {
+        printf("PASSED: 10/10 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/10 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Message_DecodeWith()\n");
+    // Two streams decoded a character at a time, interleaved, do not disturb each other.
+    MessageDecoder first, second;
+    const char *a = "$SHO,2,9*5F\n";
+    const char *b = "$CHA,43182*5A\n";
+    BB_Event firstEvent = {BB_EVENT_NO_EVENT, 0, 0, 0}, secondEvent = firstEvent;
+    Message_DecoderInit(&first);
+    Message_DecoderInit(&second);
+    while (*a || *b) {
+        if (*a) {
+            Message_DecodeWith(&first, (unsigned char) *a++, &event);
+            if (event.type != BB_EVENT_NO_EVENT) {
+                firstEvent = event;
+            }
+        }
+        if (*b) {
+            Message_DecodeWith(&second, (unsigned char) *b++, &event);
+            if (event.type != BB_EVENT_NO_EVENT) {
+                secondEvent = event;
+            }
+        }
+    }
+    if (firstEvent.type == BB_EVENT_SHO_RECEIVED && firstEvent.param1 == 9) {
+        resCount++;
+    }
+    if (secondEvent.type == BB_EVENT_CHA_RECEIVED && secondEvent.param0 == 43182) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing Message_DecodeBuffer()\n");
+    // Noise longer than a vector, a message split between calls, and errors, in one stream.
+    const char *stream = "noise before the first message, longer than 32 bytes "
+            "$SHO,2,9*5F\n$RES,4,8,1*55\n$SHO,2,9*5f\n$CAP,7,0*55\n";
+    const size_t streamLen = strlen(stream);
+    BB_Event events[8];
+    size_t numEvents, used, split;
+    MessageDecoder bufferDecoder;
+    Message_DecoderInit(&bufferDecoder);
+    numEvents = Message_DecodeBufferWith(&bufferDecoder, (const uint8_t *) stream, 60, events, 8,
+            &used);
+    numEvents += Message_DecodeBufferWith(&bufferDecoder, (const uint8_t *) stream + 60,
+            streamLen - 60, events + numEvents, 8 - numEvents, NULL);
+    if (used == 60 && numEvents == 4 && events[0].type == BB_EVENT_SHO_RECEIVED &&
+            events[0].param1 == 9 && events[1].type == BB_EVENT_RES_RECEIVED &&
+            events[1].param2 == 1 && events[2].type == BB_EVENT_ERROR &&
+            events[3].type == BB_EVENT_CAP_RECEIVED && events[3].param0 == 7) {
+        resCount++;
+    }
+    // With room for one event, decoding stops just after the byte that produced it.
+    split = strlen("noise before the first message, longer than 32 bytes $SHO,2,9*5F\n");
+    Message_DecoderInit(&bufferDecoder);
+    numEvents = Message_DecodeBufferWith(&bufferDecoder, (const uint8_t *) stream, streamLen,
+            events, 1, &used);
+    if (numEvents == 1 && used == split && events[0].type == BB_EVENT_SHO_RECEIVED) {
+        resCount++;
+    }
+    // A payload too long is rejected where Message_Decode() rejects it.
+    char longMessage[MESSAGE_MAX_LEN + 8] = "$CHA,";
+    memset(longMessage + 5, '1', MESSAGE_MAX_PAYLOAD_LEN);
+    longMessage[MESSAGE_MAX_PAYLOAD_LEN + 2] = '\0'; // '$' and one character too many.
+    numEvents = Message_DecodeBufferWith(&bufferDecoder, (const uint8_t *) longMessage,
+            strlen(longMessage), events, 8, &used);
+    if (numEvents == 1 && used == MESSAGE_MAX_PAYLOAD_LEN + 2 &&
+            events[0].param0 == BB_ERROR_PAYLOAD_LEN_EXCEEDED &&
+            DecodeString(longMessage).param0 == BB_ERROR_PAYLOAD_LEN_EXCEEDED) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
 
     return (EXIT_SUCCESS);
 }
-
@@ -5,14 +5,53 @@
  * Created on December 5, 2023, 11:56 AM
  */
 
-#include <stdio.h>
-#include <stdlib.h>
+#include "Negotiation.h"
+#include "BOARD.h"
 
-/*
- * 
+/**
+ * This function implements a one-way hash.  It maps its input, A, 
+ * into an image, #a, in a way that is hard to reverse, but easy 
+ * to reproduce.
+ * @param secret        //A number that a challenger commits to
+ * @return hash         //the hashed value of the secret commitment.
+ *
+ * This function implements the "Beef Hash," a variant of a Rabin hash.
+ * The result is ((the square of the input) modulo the constant key 0xBEEF).
  */
-int main(int argc, char** argv) {
+NegotiationData NegotiationHash(NegotiationData secret)
+{
+    // The square of a 16-bit secret needs 32 bits.
+    return (NegotiationData) (((uint32_t) secret * secret) % PUBLIC_KEY);
+}
 
-    return (EXIT_SUCCESS);
+/**
+ * Detect cheating.  An accepting agent will receive both a commitment hash
+ * and a secret number from the challenging agent.  This function
+ * verifies that the secret and the commitment hash agree, hopefully
+ * detecting cheating by the challenging agent.
+ *
+ * @param secret        //the previously secret number that the challenging agent has revealed
+ * @param commitment    //the hash of the secret number
+ * @return TRUE if the commitment validates the revealed secret, FALSE otherwise
+ */
+int NegotiationVerify(NegotiationData secret, NegotiationData commitment)
+{
+    return NegotiationHash(secret) == commitment ? TRUE : FALSE;
 }
 
+/**
+ * The coin-flip protocol uses random numbers generated by both
+ * agents to determine the outcome of the coin flip.
+ *
+ * If the parity of A XOR B is 1, then the outcome is HEADS.  Otherwise, the outcome is TAILS.
+ */
+NegotiationOutcome NegotiateCoinFlip(NegotiationData A, NegotiationData B)
+{
+    NegotiationData bits = A ^ B;
+    uint8_t parity = 0;
+    while (bits) {
+        parity ^= 1;
+        bits &= bits - 1; // Clears the lowest set bit.
+    }
+    return parity ? HEADS : TAILS;
+}
@@ -7,12 +7,63 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "BOARD.h"
+#include "Negotiation.h"
 
 /*
  * 
  */
 int main(int argc, char** argv) {
+    BOARD_Init();
+    int resCount = 0;
+    printf("Welcome to the Negotiation.c Test!\n");
+
+    printf("Now Testing NegotiationHash()\n");
+    if (NegotiationHash(3) == 9) {
+        resCount++;
+    }
+    if (NegotiationHash(12345) == 43182) {
+        resCount++;
+    }
+    if (NegotiationHash(0xFFFF) < PUBLIC_KEY) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing NegotiationVerify()\n");
+    if (NegotiationVerify(12345, 43182) == TRUE) {
+        resCount++;
+    }
+    if (NegotiationVerify(12346, 43182) == FALSE) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing NegotiateCoinFlip()\n");
+    if (NegotiateCoinFlip(0b01101011, 0) == HEADS) {
+        resCount++;
+    }
+    if (NegotiateCoinFlip(0b0110, 0b0011) == TAILS) {
+        resCount++;
+    }
+    if (NegotiateCoinFlip(0xFFFF, 0x7FFF) == HEADS) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
 
     return (EXIT_SUCCESS);
 }
-
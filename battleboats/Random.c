@@ -0,0 +1,43 @@
+/*
+ * File:   Random.c
+ *
+ * Seeding for the xoshiro128** generator. See Random.h.
+ */
+
+#include "Random.h"
+
+RandomState randomDefault = {{0x9E3779B9UL, 0x243F6A88UL, 0xB7E15162UL, 0x6A09E667UL}};
+
+/**
+ * One step of splitmix32, which spreads a 32-bit seed over the generator's 128 bits of state.
+ */
+static uint32_t RandomSplitMix(uint32_t *x)
+{
+    uint32_t z = (*x += 0x9E3779B9UL);
+    z = (z ^ (z >> 16)) * 0x85EBCA6BUL;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35UL;
+    return z ^ (z >> 16);
+}
+
+void RandomSeed(RandomState *r, uint32_t seed)
+{
+    int i;
+    for (i = 0; i < 4; i++) {
+        r->s[i] = RandomSplitMix(&seed);
+    }
+    // xoshiro never leaves the all-zero state, so it must never be seeded with it.
+    if ((r->s[0] | r->s[1] | r->s[2] | r->s[3]) == 0) {
+        r->s[0] = 1;
+    }
+}
+
+void RandomStir(RandomState *r, uint32_t entropy)
+{
+    uint32_t x = entropy;
+    r->s[0] ^= RandomSplitMix(&x);
+    r->s[2] ^= RandomSplitMix(&x);
+    if ((r->s[0] | r->s[1] | r->s[2] | r->s[3]) == 0) {
+        r->s[0] = 1;
+    }
+    RandomNext(r);
+}
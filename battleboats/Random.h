@@ -0,0 +1,61 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/**
+ * A small, fast pseudo-random generator (xoshiro128**) whose whole state is held by the caller.
+ * Every agent and field routine that needs random numbers takes one of these instead of calling
+ * rand(), so games running side by side never share hidden state, and a game started from the
+ * same seed always plays out the same way.
+ *
+ * A RandomState must be seeded with RandomSeed() before use.
+ */
+typedef struct {
+    uint32_t s[4];
+} RandomState;
+
+/**
+ * Seeds `r`. Any seed, including 0, gives a valid and distinct stream.
+ */
+void RandomSeed(RandomState *r, uint32_t seed);
+
+/**
+ * Mixes `entropy` (e.g. a timer value captured at a button press) into `r` without resetting it.
+ */
+void RandomStir(RandomState *r, uint32_t entropy);
+
+/**
+ * A generator for code that has no state of its own to pass, such as FieldAIPlaceAllBoats().
+ * It starts from a fixed seed; it is not safe to share between threads.
+ */
+extern RandomState randomDefault;
+
+/**
+ * Returns the next 32 random bits from `r`.
+ */
+static inline uint32_t RandomNext(RandomState *r)
+{
+    uint32_t *s = r->s;
+    uint32_t x = s[1] * 5;
+    uint32_t result = ((x << 7) | (x >> 25)) * 9;
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+}
+
+/**
+ * Returns a random number in [0, bound), by scaling rather than with %. The bias is below
+ * bound / 2^32, which is negligible for every bound used here.
+ */
+static inline uint32_t RandomBelow(RandomState *r, uint32_t bound)
+{
+    return (uint32_t) (((uint64_t) RandomNext(r) * bound) >> 32);
+}
+
+#endif // RANDOM_H
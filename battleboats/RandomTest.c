@@ -0,0 +1,99 @@
+/*
+ * File:   RandomTest.c
+ *
+ * Tests for the xoshiro128** generator in Random.c.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "Random.h"
+
+int main(int argc, char** argv) {
+    BOARD_Init();
+    int resCount = 0;
+    int i;
+    RandomState r, s;
+    printf("Welcome to the Random.c Test!\n");
+
+    printf("Now Testing RandomNext()\n");
+    // Reference outputs of xoshiro128** from the state {1, 2, 3, 4}.
+    r.s[0] = 1;
+    r.s[1] = 2;
+    r.s[2] = 3;
+    r.s[3] = 4;
+    if (RandomNext(&r) == 11520) {
+        resCount++;
+    }
+    if (RandomNext(&r) == 0) {
+        resCount++;
+    }
+    if (RandomNext(&r) == 5927040) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing RandomSeed() and RandomStir()\n");
+    RandomSeed(&r, 42);
+    RandomSeed(&s, 42);
+    for (i = 0; i < 100 && RandomNext(&r) == RandomNext(&s); i++);
+    if (i == 100) {
+        resCount++;
+    }
+    RandomSeed(&s, 43);
+    if (RandomNext(&r) != RandomNext(&s)) {
+        resCount++;
+    }
+    RandomSeed(&r, 0);
+    if ((r.s[0] | r.s[1] | r.s[2] | r.s[3]) != 0) {
+        resCount++;
+    }
+    RandomSeed(&r, 42);
+    RandomSeed(&s, 42);
+    RandomStir(&s, 7);
+    if (RandomNext(&r) != RandomNext(&s)) {
+        resCount++;
+    }
+    if (resCount == 4) {
+        printf("PASSED: 4/4 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/4 TESTS PASSED\n", resCount);
+    }
+
+    resCount = 0;
+    printf("Now Testing RandomBelow()\n");
+    // Every value of a small bound turns up, roughly equally often.
+    uint32_t counts[6] = {0, 0, 0, 0, 0, 0};
+    uint8_t inRange = TRUE;
+    RandomSeed(&r, 1);
+    for (i = 0; i < 60000; i++) {
+        uint32_t v = RandomBelow(&r, 6);
+        if (v >= 6) {
+            inRange = FALSE;
+            break;
+        }
+        counts[v]++;
+    }
+    if (inRange) {
+        resCount++;
+    }
+    for (i = 0; i < 6 && counts[i] > 9500 && counts[i] < 10500; i++);
+    if (i == 6) {
+        resCount++;
+    }
+    if (RandomBelow(&r, 1) == 0) {
+        resCount++;
+    }
+    if (resCount == 3) {
+        printf("PASSED: 3/3 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/3 TESTS PASSED\n", resCount);
+    }
+
+    return (EXIT_SUCCESS);
+}
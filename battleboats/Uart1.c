@@ -1,4 +1,4 @@
-#include "CircularBuffer.h"
+#include "ByteQueue.h"
 #include "Uart1.h"
 
 //CSE13E Support Library
@@ -7,10 +7,18 @@
 #include <xc.h>
 #include <sys/attribs.h>
 
-static CircularBuffer uart1RxBuffer;
+/*
+ * Each queue has one producer and one consumer: the interrupts fill uart1RxQueue and the main
+ * code empties it, and the main code fills uart1TxQueue and the interrupts empty it.  Neither
+ * needs interrupts masked to stay consistent (see ByteQueue.h).  The Uno32's PIC32MX320F128H has
+ * no DMA controller, so the UART interrupt moves every byte.
+ */
+static ByteQueue uart1RxQueue;
 static uint8_t u1RxBuf[1024];
-static CircularBuffer uart1TxBuffer;
+static ByteQueue uart1TxQueue;
 static uint8_t u1TxBuf[1024];
+static void (*uart1TxDoneCallback)(void);
+static volatile uint8_t uart1TxPending;
 
 /*
  * Private functions.
@@ -21,14 +29,14 @@ void Uart1StartTransmission(void);
  * Initialization function for the UART_USED peripheral.
  * Should be called in initialization code for the
  * model. This function configures the UART
- * for whatever baud rate is specified. It also configures two circular buffers
+ * for whatever baud rate is specified. It also configures two byte queues
  * for transmission and reception.
  */
 void Uart1Init(uint32_t baudRate)
 {
-    // First initialize the necessary circular buffers.
-    CB_Init(&uart1RxBuffer, u1RxBuf, sizeof (u1RxBuf));
-    CB_Init(&uart1TxBuffer, u1TxBuf, sizeof (u1TxBuf));
+    // First initialize the necessary byte queues.
+    ByteQueue_Init(&uart1RxQueue, u1RxBuf, sizeof (u1RxBuf));
+    ByteQueue_Init(&uart1TxQueue, u1TxBuf, sizeof (u1TxBuf));
 
 #ifdef PIC32MX
     //the next few lines below are redundant with actions performed in BOARD_Init():
@@ -69,7 +77,7 @@ void Uart1ChangeBaudRate(uint16_t brgRegister)
 
 uint8_t Uart1HasData(void)
 {
-    return (uart1RxBuffer.dataSize > 0);
+    return (ByteQueue_Count(&uart1RxQueue) > 0);
 }
 
 /**
@@ -83,17 +91,30 @@ uint8_t Uart1HasData(void)
  */
 void Uart1StartTransmission(void)
 {
-    while (uart1TxBuffer.dataSize > 0 && !U1STAbits.UTXBF) {
-        // A temporary variable is used here because writing directly into U1TXREG causes some weird issues.
-        uint8_t c;
-        CB_ReadByte(&uart1TxBuffer, &c);
+    // A temporary variable is used here because writing directly into U1TXREG causes some weird issues.
+    uint8_t c;
+    while (!U1STAbits.UTXBF && ByteQueue_ReadByte(&uart1TxQueue, &c)) {
         U1TXREG = c;
     }
 }
 
 int Uart1ReadByte(uint8_t *datum)
 {
-    return CB_ReadByte(&uart1RxBuffer, datum);
+    return ByteQueue_ReadByte(&uart1RxQueue, datum);
+}
+
+/**
+ * Bytes are queued without masking interrupts, but both this and the UART interrupt start
+ * transmissions, so the interrupts are masked while this one does.
+ */
+static void Uart1KickTransmission(void)
+{
+    uint32_t interrupts;
+
+    uart1TxPending = TRUE;
+    interrupts = BOARD_DisableInterrupts();
+    Uart1StartTransmission();
+    BOARD_RestoreInterrupts(interrupts);
 }
 
 /**
@@ -102,8 +123,8 @@ int Uart1ReadByte(uint8_t *datum)
  */
 void Uart1WriteByte(uint8_t datum)
 {
-    CB_WriteByte(&uart1TxBuffer, datum);
-    Uart1StartTransmission();
+    ByteQueue_WriteByte(&uart1TxQueue, datum);
+    Uart1KickTransmission();
 }
 
 /**
@@ -112,13 +133,43 @@ void Uart1WriteByte(uint8_t datum)
  */
 int Uart1WriteData(const void *data, size_t length)
 {
-    int success = CB_WriteMany(&uart1TxBuffer, data, length, FALSE);
+    int success = ByteQueue_Write(&uart1TxQueue, data, length);
+    Uart1KickTransmission();
+    return success;
+}
 
-    Uart1StartTransmission();
+/**
+ * The main loop is the only consumer of the receive queue and the only producer of the transmit
+ * queue, so the spans need no masking: the interrupts only ever add received bytes after a read
+ * span and only ever remove sent bytes before a write span.
+ */
+const uint8_t *Uart1GetReadSpan(uint16_t *size)
+{
+    return ByteQueue_GetReadSpan(&uart1RxQueue, size);
+}
+
+void Uart1CommitRead(uint16_t size)
+{
+    ByteQueue_CommitRead(&uart1RxQueue, size);
+}
+
+uint8_t *Uart1GetWriteSpan(uint16_t *size)
+{
+    return ByteQueue_GetWriteSpan(&uart1TxQueue, size);
+}
 
+int Uart1CommitWrite(uint16_t size)
+{
+    int success = ByteQueue_CommitWrite(&uart1TxQueue, size);
+    Uart1KickTransmission();
     return success;
 }
 
+void Uart1SetTxDoneCallback(void (*callback)(void))
+{
+    uart1TxDoneCallback = callback;
+}
+
 #ifdef PIC32MX
 
 void __ISR(_UART_1_VECTOR, ipl6auto) Uart1Interrupt(void)
@@ -127,7 +178,7 @@ void __ISR(_UART_1_VECTOR, ipl6auto) Uart1Interrupt(void)
     if (IFS0bits.U1RXIF) {
         // Keep receiving new bytes while the buffer has data.
         while (U1STAbits.URXDA == 1) {
-            CB_WriteByte(&uart1RxBuffer, (uint8_t) U1RXREG);
+            ByteQueue_WriteByte(&uart1RxQueue, (uint8_t) U1RXREG);
         }
 
         // Clear buffer overflow bit if triggered
@@ -143,6 +194,15 @@ void __ISR(_UART_1_VECTOR, ipl6auto) Uart1Interrupt(void)
     if (IFS0bits.U1TXIF) {
         Uart1StartTransmission();
 
+        // The interrupt fires when the shift register empties, so once nothing is left to load
+        // the last byte is out on the wire.
+        if (uart1TxPending && ByteQueue_Count(&uart1TxQueue) == 0 && U1STAbits.TRMT) {
+            uart1TxPending = FALSE;
+            if (uart1TxDoneCallback) {
+                uart1TxDoneCallback();
+            }
+        }
+
         // Clear the interrupt flag
         IFS0bits.U1TXIF = 0;
     }
@@ -5,12 +5,11 @@
 // Add Uart1Init() to an initialization sequence called once on startup.
 // Use Uart1Write*Data() to push appropriately-sized data chunks into the queue and begin transmission.
 // Use Uart1ReadByte() to read bytes out of the buffer
+// Or use the Uart1Get*Span()/Uart1Commit*() pairs to read and write the buffers in place.
 
 #include <stddef.h>
 #include <stdint.h>
 
-#include "CircularBuffer.h"
-
 /**
  * Initializes the UART1 peripheral according to the BRG SFR value passed to it.
  * @param brgRegister The value to be placed in the BRG register.
@@ -48,4 +47,36 @@ void Uart1WriteByte(uint8_t datum);
  */
 int Uart1WriteData(const void *data, size_t length);
 
+/**
+ * Returns the oldest received bytes in place, without copying them out: `size` is set to how many
+ * can be read from the returned pointer, up to where the receive queue wraps (see
+ * ByteQueue_GetReadSpan()). They stay there until Uart1CommitRead() removes them.
+ */
+const uint8_t *Uart1GetReadSpan(uint16_t *size);
+
+/**
+ * Removes `size` bytes read through Uart1GetReadSpan() from the received data buffer.
+ */
+void Uart1CommitRead(uint16_t size);
+
+/**
+ * Returns free space in the transmit queue to format data into in place: `size` is set to how
+ * many bytes can be written from the returned pointer, up to where the queue wraps (see
+ * ByteQueue_GetWriteSpan()). Nothing is sent until Uart1CommitWrite().
+ */
+uint8_t *Uart1GetWriteSpan(uint16_t *size);
+
+/**
+ * Queues `size` bytes written through Uart1GetWriteSpan() and begins transmission, like
+ * Uart1WriteData().
+ */
+int Uart1CommitWrite(uint16_t size);
+
+/**
+ * Registers a function for the UART1 interrupt to call once everything written has been sent:
+ * the transmit buffer is empty and the last byte has left the shift register. It is called once
+ * per drain, from interrupt context. Pass NULL to remove it.
+ */
+void Uart1SetTxDoneCallback(void (*callback)(void));
+
 #endif // UART1_H
@@ -436,6 +436,11 @@ class PyAgent:
 			self.last_shot = (int(payload[1]), int(payload[2]))
 		elif payload[0]=="RES":
 			pass
+		elif payload[0]=="CAP":
+			ret+= "\nCapabilities = %s (%s)" % (payload[1], "answer" if payload[2]=="1" else "offer")
+		elif payload[0]=="RAS":
+			self.last_shot = (int(payload[2]), int(payload[3]))
+			ret+= "\nResult = %s, then shot (%s, %s)" % (payload[1], payload[2], payload[3])
 		else:
 			ret+= "\nDoes not appear to have a valid message type"
 		return ret+"\n------------------------"
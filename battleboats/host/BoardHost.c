@@ -0,0 +1,152 @@
+/*
+ * File:   BoardHost.c
+ *
+ * Host replacement for BOARD.c. BOARD_Init() seeds rand() and starts a 100Hz SIGALRM tick that
+ * stands in for the board's interrupts: each tick runs the UART interrupt shim and then the Timer2
+ * ISR, TimerInterrupt100Hz(), if the program defines one. A signal handler preempts the main loop
+ * the way an interrupt does, so the game code sees the same concurrency as on the PIC32.
+ * Disabling interrupts blocks the tick, and waiting for one suspends the process until it comes.
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include <xc.h>
+#include "BOARD.h"
+
+#define HOST_TICK_HZ 100
+
+// The SFRs declared in the host xc.h.
+volatile uint32_t T2CON, PR2, IFS0CLR;
+volatile uint32_t TRISE, LATE;
+volatile uint32_t PORTD, PORTF;
+volatile HostSfrBits T2CONbits, IFS0bits, IEC0bits, IPC2bits;
+
+// Provided by Lab09_main.c and Uart1Host.c when they are linked in.
+void TimerInterrupt100Hz(void) __attribute__((weak));
+void Uart1HostInterrupt(void) __attribute__((weak));
+
+static void BoardHostTick(int signal)
+{
+    (void) signal;
+    if (Uart1HostInterrupt) {
+        Uart1HostInterrupt();
+    }
+    if (TimerInterrupt100Hz) {
+        TimerInterrupt100Hz();
+    }
+}
+
+/**
+ * Function: BOARD_Init(void)
+ * @param None
+ * @return None
+ * @brief Seeds rand() and starts the 100Hz tick if anything needs it.
+ */
+void BOARD_Init()
+{
+    srand((unsigned int) time(NULL) ^ ((unsigned int) getpid() << 16));
+
+    if (TimerInterrupt100Hz || Uart1HostInterrupt) {
+        struct sigaction action = {0};
+        struct itimerval period = {{0, 1000000 / HOST_TICK_HZ}, {0, 1000000 / HOST_TICK_HZ}};
+        action.sa_handler = BoardHostTick;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGALRM, &action, NULL);
+        setitimer(ITIMER_REAL, &period, NULL);
+    }
+}
+
+/**
+ * Function: BOARD_End(void)
+ * @param None
+ * @return None
+ * @brief Stops the 100Hz tick.
+ */
+void BOARD_End()
+{
+    struct itimerval off = {{0, 0}, {0, 0}};
+    setitimer(ITIMER_REAL, &off, NULL);
+}
+
+/**
+ * Function: BOARD_DisableInterrupts(void)
+ * @param None
+ * @return TRUE if the tick was unblocked before this call
+ * @brief Blocks the tick signal.
+ */
+uint32_t BOARD_DisableInterrupts(void)
+{
+    sigset_t tick, previous;
+    sigemptyset(&tick);
+    sigaddset(&tick, SIGALRM);
+    sigprocmask(SIG_BLOCK, &tick, &previous);
+    return !sigismember(&previous, SIGALRM);
+}
+
+/**
+ * Function: BOARD_RestoreInterrupts(uint32_t state)
+ * @param state - the value returned by BOARD_DisableInterrupts()
+ * @return None
+ * @brief Unblocks the tick signal if it was unblocked before.
+ */
+void BOARD_RestoreInterrupts(uint32_t state)
+{
+    if (state) {
+        sigset_t tick;
+        sigemptyset(&tick);
+        sigaddset(&tick, SIGALRM);
+        sigprocmask(SIG_UNBLOCK, &tick, NULL);
+    }
+}
+
+/**
+ * Function: BOARD_WaitForInterrupt(void)
+ * @param None
+ * @return None
+ * @brief Suspends the process until a signal arrives, with the tick unblocked for the wait only.
+ * A tick that arrived while it was blocked is delivered at once.
+ */
+void BOARD_WaitForInterrupt(void)
+{
+    sigset_t waiting;
+    sigprocmask(SIG_BLOCK, NULL, &waiting);
+    sigdelset(&waiting, SIGALRM);
+    sigsuspend(&waiting);
+}
+
+/**
+ * Function: BOARD_GetCoreTimer(void)
+ * @param None
+ * @return The monotonic clock, at the core timer's BOARD_CORE_TICKS_PER_MS
+ */
+uint32_t BOARD_GetCoreTimer(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) (ts.tv_sec * (BOARD_CORE_TICKS_PER_MS * 1000) +
+            ts.tv_nsec / (1000000000 / (BOARD_CORE_TICKS_PER_MS * 1000)));
+}
+
+/**
+ * Function: BOARD_GetPBClock(void)
+ * @param None
+ * @return PB_CLOCK - speed the peripheral clock is running in hertz
+ */
+unsigned int BOARD_GetPBClock()
+{
+    return 80000000L / 4;
+}
+
+/**
+ * Function: BOARD_GetSysClock(void)
+ * @param None
+ * @return SYS_CLOCK - speed the main clock is running at
+ */
+unsigned int BOARD_GetSysClock()
+{
+    return 80000000L;
+}
@@ -0,0 +1,34 @@
+/*
+ * File:   ButtonsHost.c
+ *
+ * Host replacement for the Buttons library. There are no buttons, so signals press them instead:
+ *   kill -USR1 <pid>   presses BTN4 (start/challenge)
+ *   kill -USR2 <pid>   presses BTN1 (reset)
+ */
+
+#include <signal.h>
+#include "Buttons.h"
+
+static volatile sig_atomic_t pendingEvents;
+
+static void ButtonsHostPress(int signal)
+{
+    pendingEvents |= (signal == SIGUSR1) ? BUTTON_EVENT_4DOWN : BUTTON_EVENT_1DOWN;
+}
+
+void ButtonsInit(void)
+{
+    struct sigaction action = {0};
+    action.sa_handler = ButtonsHostPress;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, NULL);
+    sigaction(SIGUSR2, &action, NULL);
+}
+
+uint8_t ButtonsCheckEvents(void)
+{
+    uint8_t events = pendingEvents;
+    pendingEvents = 0;
+    return events;
+}
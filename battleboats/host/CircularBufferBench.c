@@ -0,0 +1,172 @@
+/*
+ * File:   CircularBufferBench.c
+ *
+ * Compares CircularBuffer with ByteQueue, which carries the UART's bytes, on the traffic the UART
+ * sees: encoded messages written whole, then read back a byte at a time (as Message_Decode()
+ * consumed them) or in bulk. CircularBuffer copies a byte at a time and wraps its indices with a
+ * comparison; ByteQueue masks its indices and copies with memcpy(), or not at all through a span.
+ *
+ *     build/cbbench [-n megabytes]
+ *
+ * Each line reports nanoseconds per byte moved, best of several runs.
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "BOARD.h"
+#include "ByteQueue.h"
+#include "CircularBuffer.h"
+
+// Runs of each measurement; the fastest is reported.
+#define BENCH_RUNS 5
+
+typedef enum {
+    BENCH_READ_BYTE, BENCH_READ_MANY
+} BenchRead;
+
+static const char *benchReadNames[] = {"a byte at a time", "in bulk"};
+
+/**
+ * Returns the monotonic clock in nanoseconds.
+ */
+static uint64_t BenchNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * Fills `message` with `length` bytes of text.
+ */
+static void BenchMessage(uint8_t *message, uint16_t length)
+{
+    uint16_t i;
+    for (i = 0; i < length; i++) {
+        message[i] = (uint8_t) ('A' + i % 26);
+    }
+}
+
+/**
+ * Pushes `bytes` through `b` in messages of `length` bytes, a few at a time so the indices wrap
+ * often, and returns nanoseconds per byte. The checksum of everything read keeps the compiler
+ * from discarding the reads.
+ */
+static double BenchCircularBuffer(CircularBuffer *b, BenchRead read, uint16_t length,
+        uint64_t bytes, uint32_t *checksum)
+{
+    uint8_t message[256], out[256];
+    uint64_t moved, start;
+    uint16_t i;
+    int m;
+
+    BenchMessage(message, length);
+    start = BenchNow();
+    for (moved = 0; moved < bytes; moved += 4 * length) {
+        for (m = 0; m < 4; m++) {
+            CB_WriteMany(b, message, length, TRUE);
+        }
+        for (m = 0; m < 4; m++) {
+            if (read == BENCH_READ_BYTE) {
+                for (i = 0; i < length; i++) {
+                    CB_ReadByte(b, &out[i]);
+                }
+            } else {
+                CB_ReadMany(b, out, length);
+            }
+            *checksum += out[length - 1];
+        }
+    }
+    return (double) (BenchNow() - start) / moved;
+}
+
+/**
+ * The same as BenchCircularBuffer() for a ByteQueue. Bulk reads take the bytes through
+ * ByteQueue_GetReadSpan(), in one or two runs, as Transmission_ReceiveAll() does.
+ */
+static double BenchByteQueue(ByteQueue *q, BenchRead read, uint16_t length, uint64_t bytes,
+        uint32_t *checksum)
+{
+    uint8_t message[256], out[256];
+    uint64_t moved, start;
+    uint16_t i, run, got;
+    int m;
+
+    BenchMessage(message, length);
+    start = BenchNow();
+    for (moved = 0; moved < bytes; moved += 4 * length) {
+        for (m = 0; m < 4; m++) {
+            ByteQueue_Write(q, message, length);
+        }
+        for (m = 0; m < 4; m++) {
+            if (read == BENCH_READ_BYTE) {
+                for (i = 0; i < length; i++) {
+                    ByteQueue_ReadByte(q, &out[i]);
+                }
+            } else {
+                for (got = 0; got < length; got += run) {
+                    const uint8_t *span = ByteQueue_GetReadSpan(q, &run);
+                    if (run > length - got) {
+                        run = length - got;
+                    }
+                    memcpy(&out[got], span, run);
+                    ByteQueue_CommitRead(q, run);
+                }
+            }
+            *checksum += out[length - 1];
+        }
+    }
+    return (double) (BenchNow() - start) / moved;
+}
+
+int main(int argc, char** argv)
+{
+    static uint8_t storage[1024];
+    static const uint16_t lengths[] = {14, 82};
+    uint64_t bytes = 64ULL << 20;
+    uint32_t checksum = 0;
+    CircularBuffer b;
+    ByteQueue q;
+    int opt, read, l, s, run;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n') {
+            bytes = strtoull(optarg, NULL, 10) << 20;
+        } else {
+            fprintf(stderr, "usage: %s [-n megabytes]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("%-18s %8s %14s %12s %8s\n", "read", "message", "CircularBuffer", "ByteQueue",
+            "speedup");
+    for (read = BENCH_READ_BYTE; read <= BENCH_READ_MANY; read++) {
+        for (l = 0; l < 2; l++) {
+            double best[2];
+            for (s = 0; s < 2; s++) {
+                best[s] = 1e9;
+                for (run = 0; run < BENCH_RUNS; run++) {
+                    double ns;
+                    if (s == 0) {
+                        CB_Init(&b, storage, sizeof (storage));
+                        ns = BenchCircularBuffer(&b, read, lengths[l], bytes / BENCH_RUNS,
+                                &checksum);
+                    } else {
+                        ByteQueue_Init(&q, storage, sizeof (storage));
+                        ns = BenchByteQueue(&q, read, lengths[l], bytes / BENCH_RUNS, &checksum);
+                    }
+                    if (ns < best[s]) {
+                        best[s] = ns;
+                    }
+                }
+            }
+            printf("%-18s %6u B %11.3f ns %9.3f ns %7.2fx\n", benchReadNames[read], lengths[l],
+                    best[0], best[1], best[0] / best[1]);
+        }
+    }
+    printf("(checksum %u)\n", checksum);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,319 @@
+/*
+ * File:   LinkRelayTest.c
+ *
+ * Host-only test of the Link (see Link.h) in the whole firmware. Plays
+ * build/battleboats-negotiating against itself through a relay, as socat would, except that the
+ * relay damages one message once the boards have agreed on capabilities. It checks that the game
+ * still reaches its end, and that both boards fell back to text to get there. Another game has
+ * the relay hold back the CAP answer until the challenger has given up on it.
+ *
+ * The relay decodes both directions with Message_DecodeWith() and MessageBinary_DecodeWith(), so
+ * it knows where each message ends and what it says, and holds each message's bytes until then.
+ * Only messages it passes on intact count towards the end of the game.
+ */
+
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "BOARD.h"
+#include "Capability.h"
+#include "Field.h"
+#include "Message.h"
+#include "MessageBinary.h"
+
+// How long a game may take, damage and recovery included, in milliseconds.
+#define LINK_RELAY_DEADLINE 20000
+// The agent message, counted from the first after the agreement, that is damaged.
+#define LINK_RELAY_DAMAGE_AT 10
+// Damage the message that sinks a board's last boat instead.
+#define LINK_RELAY_DAMAGE_LAST -1
+// Damage nothing.
+#define LINK_RELAY_DAMAGE_NONE 0
+// How long a late CAP answer is held back, in milliseconds; well over LINK_OFFER_TIMEOUT.
+#define LINK_RELAY_ANSWER_DELAY 1000
+
+/**
+ * One direction of the relay: the board it reads from and the board it writes to.
+ */
+typedef struct {
+    int from;
+    int to;
+    MessageDecoder text;
+    MessageBinaryDecoder binary;
+    uint8_t pending[256];
+    int length;
+    int messages;        // Agent messages since the agreement.
+    uint8_t sunk;        // The boats of the sending board that its messages report sunk.
+    uint8_t textLater;   // Whether it sent an agent message as text after the damage.
+    int binaryMessages;  // Agent messages it sent as binary frames.
+} LinkRelayPipe;
+
+typedef struct {
+    pid_t pid[2];
+    LinkRelayPipe pipe[2];
+    uint8_t agreed;
+    uint8_t damaged;
+    int damageSide;
+    int damageAt;
+    uint8_t delayAnswer;  // Whether to hold back the CAP answer.
+    uint8_t delayed[256]; // The answer, while it is held back.
+    int delayedLength;
+    int delayedTo;
+    long releaseAt;
+} LinkRelayGame;
+
+static const char *linkRelayExe;
+
+static long LinkRelayNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * Starts a board with its stdin and stdout on pipes, and returns its pid.
+ */
+static pid_t LinkRelayStart(int *toBoard, int *fromBoard)
+{
+    int in[2], out[2];
+    pid_t pid;
+    if (pipe(in) != 0 || pipe(out) != 0) {
+        return -1;
+    }
+    pid = fork();
+    if (pid == 0) {
+        dup2(in[0], STDIN_FILENO);
+        dup2(out[1], STDOUT_FILENO);
+        close(in[0]), close(in[1]), close(out[0]), close(out[1]);
+        freopen("/dev/null", "w", stderr);
+        execl(linkRelayExe, linkRelayExe, (char *) NULL);
+        _exit(EXIT_FAILURE);
+    }
+    close(in[0]);
+    close(out[1]);
+    *toBoard = in[1];
+    *fromBoard = out[0];
+    return pid;
+}
+
+/**
+ * Damages a message held in `pipe` so that it fails to decode: the last byte before its
+ * delimiter changes, but never to a delimiter.
+ */
+static void LinkRelayDamage(LinkRelayPipe *pipe)
+{
+    uint8_t *byte = &pipe->pending[pipe->length - 2];
+    *byte = (*byte == 0x01) ? 0x02 : *byte ^ 0x01;
+}
+
+/**
+ * Relays one byte from the board on side `side`, passing its message on once the message ends.
+ */
+static void LinkRelayRelay(LinkRelayGame *game, int side, uint8_t byte)
+{
+    LinkRelayPipe *pipe = &game->pipe[side];
+    BB_Event text, binary, *event = NULL;
+    uint8_t isText = FALSE;
+
+    pipe->pending[pipe->length++] = byte;
+    Message_DecodeWith(&pipe->text, byte, &text);
+    MessageBinary_DecodeWith(&pipe->binary, byte, &binary);
+    if (text.type != BB_EVENT_NO_EVENT && text.type != BB_EVENT_ERROR) {
+        event = &text;
+        isText = TRUE;
+        MessageBinary_DecoderInit(&pipe->binary);
+    } else if (binary.type != BB_EVENT_NO_EVENT) {
+        event = &binary;
+        Message_DecoderInit(&pipe->text);
+    }
+    if (event == NULL && pipe->length < (int) sizeof (pipe->pending)) {
+        return;
+    }
+
+    if (event != NULL && event->type == BB_EVENT_CAP_RECEIVED &&
+            event->param1 == CAPABILITY_ANSWER) {
+        game->agreed = TRUE;
+        if (game->delayAnswer) {
+            memcpy(game->delayed, pipe->pending, pipe->length);
+            game->delayedLength = pipe->length;
+            game->delayedTo = pipe->to;
+            game->releaseAt = LinkRelayNow() + LINK_RELAY_ANSWER_DELAY;
+            game->delayAnswer = FALSE;
+            pipe->length = 0;
+            return;
+        }
+    } else if (event != NULL && event->type != BB_EVENT_ERROR && game->agreed) {
+        uint16_t result = RESULT_MISS;
+        if (event->type == BB_EVENT_RES_RECEIVED) {
+            result = event->param2;
+        } else if (event->type == BB_EVENT_RAS_RECEIVED) {
+            result = event->param0;
+        }
+        pipe->messages++;
+        if (!game->damaged && (game->damageSide < 0 || side == game->damageSide) &&
+                (game->damageAt == LINK_RELAY_DAMAGE_LAST ?
+                result >= RESULT_SMALL_BOAT_SUNK && (pipe->sunk |
+                (1 << (result - RESULT_SMALL_BOAT_SUNK))) == 0x0F :
+                pipe->messages == game->damageAt)) {
+            LinkRelayDamage(pipe);
+            game->damaged = TRUE;
+        } else {
+            if (result >= RESULT_SMALL_BOAT_SUNK && result <= RESULT_HUGE_BOAT_SUNK) {
+                pipe->sunk |= 1 << (result - RESULT_SMALL_BOAT_SUNK);
+            }
+            if (game->damaged && isText) {
+                pipe->textLater = TRUE;
+            }
+            if (!isText) {
+                pipe->binaryMessages++;
+            }
+        }
+    }
+    if (write(pipe->to, pipe->pending, pipe->length) != pipe->length) {
+        perror("write");
+    }
+    pipe->length = 0;
+}
+
+/**
+ * Plays one game, damaging a message from side `game->damageSide` (0 is the challenger, -1 either)
+ * as `game->damageAt` says, and holding back the CAP answer if `game->delayAnswer` is set. Returns
+ * TRUE if the game ended.
+ */
+static uint8_t LinkRelayPlay(LinkRelayGame *game)
+{
+    int fd[2][2];
+    int side;
+    long deadline;
+    uint8_t ended = FALSE;
+
+    for (side = 0; side < 2; side++) {
+        game->pid[side] = LinkRelayStart(&fd[side][0], &fd[side][1]);
+        Message_DecoderInit(&game->pipe[side].text);
+        MessageBinary_DecoderInit(&game->pipe[side].binary);
+    }
+    for (side = 0; side < 2; side++) {
+        game->pipe[side].from = fd[side][1];
+        game->pipe[side].to = fd[1 - side][0];
+    }
+
+    // Give both boards time to start, then press BTN4 on the challenger.
+    usleep(300000);
+    kill(game->pid[0], SIGUSR1);
+
+    deadline = LinkRelayNow() + LINK_RELAY_DEADLINE;
+    while (!ended && LinkRelayNow() < deadline) {
+        struct pollfd fds[2] = {{fd[0][1], POLLIN, 0}, {fd[1][1], POLLIN, 0}};
+        if (game->delayedLength > 0 && LinkRelayNow() >= game->releaseAt) {
+            if (write(game->delayedTo, game->delayed, game->delayedLength) !=
+                    game->delayedLength) {
+                perror("write");
+            }
+            game->delayedLength = 0;
+        }
+        if (poll(fds, 2, 50) <= 0) {
+            continue;
+        }
+        for (side = 0; side < 2; side++) {
+            uint8_t bytes[256];
+            ssize_t n, i;
+            if (!(fds[side].revents & (POLLIN | POLLHUP))) {
+                continue;
+            }
+            n = read(fd[side][1], bytes, sizeof (bytes));
+            for (i = 0; i < n; i++) {
+                LinkRelayRelay(game, side, bytes[i]);
+            }
+            if (game->pipe[side].sunk == 0x0F) {
+                ended = TRUE;
+            }
+        }
+    }
+
+    for (side = 0; side < 2; side++) {
+        kill(game->pid[side], SIGKILL);
+        waitpid(game->pid[side], NULL, 0);
+        close(fd[side][0]);
+        close(fd[side][1]);
+    }
+    return ended;
+}
+
+/**
+ * Runs one case of the test and prints its result: the game ends in spite of the damage, and
+ * both boards then use text.
+ */
+static void LinkRelayCase(const char *name, int damageSide, int damageAt)
+{
+    LinkRelayGame game;
+    int resCount = 0;
+    memset(&game, 0, sizeof (game));
+    game.damageSide = damageSide;
+    game.damageAt = damageAt;
+    printf("Now Testing a damaged message %s\n", name);
+    if (LinkRelayPlay(&game) && game.damaged) {
+        resCount++;
+    }
+    if (game.pipe[0].textLater && game.pipe[1].textLater) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+}
+
+/**
+ * Runs the case where the CAP answer arrives after the challenger has given up on it and
+ * challenged in text, and prints its result: the challenger takes up the answer and sends its CHA
+ * again as a binary frame, and the game ends.
+ */
+static void LinkRelayLateCase(void)
+{
+    LinkRelayGame game;
+    int resCount = 0;
+    memset(&game, 0, sizeof (game));
+    game.damageSide = -1;
+    game.damageAt = LINK_RELAY_DAMAGE_NONE;
+    game.delayAnswer = TRUE;
+    printf("Now Testing a late answer\n");
+    if (LinkRelayPlay(&game)) {
+        resCount++;
+    }
+    if (game.pipe[0].binaryMessages > 0) {
+        resCount++;
+    }
+    if (resCount == 2) {
+        printf("PASSED: 2/2 TESTS PASSED\n");
+    } else {
+        printf("FAILED: %d/2 TESTS PASSED\n", resCount);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    static char exe[1024];
+    const char *slash = strrchr(argv[0], '/');
+
+    // build/battleboats-negotiating sits next to this test.
+    snprintf(exe, sizeof (exe), "%.*sbattleboats-negotiating",
+            slash ? (int) (slash - argv[0] + 1) : 0, argv[0]);
+    linkRelayExe = exe;
+    signal(SIGPIPE, SIG_IGN);
+    (void) argc;
+    printf("Welcome to the Link Relay Test!\n");
+
+    LinkRelayCase("from the challenger", 0, LINK_RELAY_DAMAGE_AT);
+    LinkRelayCase("from the accepter", 1, LINK_RELAY_DAMAGE_AT);
+    LinkRelayCase("that ends the game", -1, LINK_RELAY_DAMAGE_LAST);
+    LinkRelayLateCase();
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,206 @@
+/*
+ * File:   MessageBench.c
+ *
+ * Times Message_Encode() against formatting the same messages with sprintf() and the
+ * PAYLOAD_TEMPLATE_* and MESSAGE_TEMPLATE formats, which is what Message_Encode() used to do,
+ * over the mix of messages a game sends. Then times decoding recorded traffic a byte at a time
+ * with Message_DecodeWith() against a buffer at a time with Message_DecodeBufferWith().
+ *
+ *     build/msgbench [-n messages] [-m megabytes]
+ *
+ * Each line reports nanoseconds per message or per byte, best of several runs.
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "BOARD.h"
+#include "Message.h"
+
+// Runs of each measurement; the fastest is reported.
+#define BENCH_RUNS 5
+
+/**
+ * Returns the monotonic clock in nanoseconds.
+ */
+static uint64_t BenchNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * Message_Encode() as it was, with sprintf().
+ */
+static int BenchEncodeSprintf(char *message_string, Message message_to_encode)
+{
+    char payload[MESSAGE_MAX_PAYLOAD_LEN + 1];
+    switch (message_to_encode.type) {
+    case MESSAGE_CHA:
+        sprintf(payload, PAYLOAD_TEMPLATE_CHA, message_to_encode.param0);
+        break;
+    case MESSAGE_ACC:
+        sprintf(payload, PAYLOAD_TEMPLATE_ACC, message_to_encode.param0);
+        break;
+    case MESSAGE_REV:
+        sprintf(payload, PAYLOAD_TEMPLATE_REV, message_to_encode.param0);
+        break;
+    case MESSAGE_SHO:
+        sprintf(payload, PAYLOAD_TEMPLATE_SHO, message_to_encode.param0,
+                message_to_encode.param1);
+        break;
+    case MESSAGE_RES:
+        sprintf(payload, PAYLOAD_TEMPLATE_RES, message_to_encode.param0,
+                message_to_encode.param1, message_to_encode.param2);
+        break;
+    case MESSAGE_CAP:
+        sprintf(payload, PAYLOAD_TEMPLATE_CAP, message_to_encode.param0,
+                message_to_encode.param1);
+        break;
+    case MESSAGE_RAS:
+        sprintf(payload, PAYLOAD_TEMPLATE_RAS, message_to_encode.param0,
+                message_to_encode.param1, message_to_encode.param2);
+        break;
+    default:
+        message_string[0] = '\0';
+        return 0;
+    }
+    return sprintf(message_string, MESSAGE_TEMPLATE, payload, Message_CalculateChecksum(payload));
+}
+
+/**
+ * Encodes `count` messages from `messages` in turn with `encode`, and returns nanoseconds per
+ * message. The sum of the lengths keeps the compiler from discarding the work.
+ */
+static double BenchRun(int (*encode)(char *, Message), const Message *messages, int numMessages,
+        uint64_t count, uint64_t *checksum)
+{
+    char encoded[MESSAGE_MAX_LEN + 1];
+    uint64_t i, start = BenchNow();
+
+    for (i = 0; i < count; i++) {
+        *checksum += encode(encoded, messages[i % numMessages]);
+    }
+    return (double) (BenchNow() - start) / count;
+}
+
+/**
+ * Fills `traffic` with encoded messages from `messages`, with a line of trace output after every
+ * eight of them, and returns how many bytes it used.
+ */
+static size_t BenchRecordTraffic(uint8_t *traffic, size_t size, const Message *messages,
+        int numMessages)
+{
+    static const char trace[] = "Entering ATTACKING (queues: timer 0/0, uart 1/0, rx 2/0)\n";
+    size_t used = 0;
+    int i;
+
+    for (i = 0; used + MESSAGE_MAX_LEN + sizeof (trace) < size; i++) {
+        used += Message_Encode((char *) traffic + used, messages[i % numMessages]);
+        if (i % 8 == 7) {
+            memcpy(traffic + used, trace, sizeof (trace) - 1);
+            used += sizeof (trace) - 1;
+        }
+    }
+    return used;
+}
+
+/**
+ * Decodes `length` bytes of `traffic` `passes` times, a byte at a time or in 4KB buffers, and
+ * returns nanoseconds per byte. The event count keeps the compiler from discarding the work.
+ */
+static double BenchDecode(uint8_t inBuffers, const uint8_t *traffic, size_t length, int passes,
+        uint64_t *checksum)
+{
+    static BB_Event events[4096];
+    MessageDecoder decoder;
+    uint64_t start;
+    size_t i, n;
+    int pass;
+
+    Message_DecoderInit(&decoder);
+    start = BenchNow();
+    for (pass = 0; pass < passes; pass++) {
+        if (inBuffers) {
+            for (i = 0; i < length; i += n) {
+                n = length - i < 4096 ? length - i : 4096;
+                *checksum += Message_DecodeBufferWith(&decoder, traffic + i, n, events, n, NULL);
+            }
+        } else {
+            for (i = 0; i < length; i++) {
+                BB_Event event;
+                Message_DecodeWith(&decoder, traffic[i], &event);
+                *checksum += event.type;
+            }
+        }
+    }
+    return (double) (BenchNow() - start) / ((uint64_t) length * passes);
+}
+
+int main(int argc, char** argv)
+{
+    // The shots that make up most of a game, and the messages that start it.
+    static const Message mixes[][4] = {
+        {{MESSAGE_SHO, 3, 7, 0}, {MESSAGE_RES, 3, 7, 1}, {MESSAGE_SHO, 0, 9, 0},
+            {MESSAGE_RES, 5, 2, 0}},
+        {{MESSAGE_CHA, 43182, 0, 0}, {MESSAGE_ACC, 57203, 0, 0}, {MESSAGE_REV, 9034, 0, 0},
+            {MESSAGE_CAP, 7, 1, 0}},
+    };
+    static const char *mixNames[] = {"SHO/RES", "CHA/ACC/REV/CAP"};
+    static uint8_t traffic[1 << 20];
+    uint64_t count = 10000000, megabytes = 256;
+    uint64_t checksum = 0;
+    int opt, mix, run;
+
+    while ((opt = getopt(argc, argv, "n:m:")) != -1) {
+        if (opt == 'n') {
+            count = strtoull(optarg, NULL, 10);
+        } else if (opt == 'm') {
+            megabytes = strtoull(optarg, NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n messages] [-m megabytes]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("%-18s %12s %16s %8s\n", "messages", "sprintf()", "Message_Encode()", "speedup");
+    for (mix = 0; mix < 2; mix++) {
+        double best[2] = {1e9, 1e9};
+        for (run = 0; run < BENCH_RUNS; run++) {
+            double ns = BenchRun(BenchEncodeSprintf, mixes[mix], 4, count / BENCH_RUNS, &checksum);
+            if (ns < best[0]) {
+                best[0] = ns;
+            }
+            ns = BenchRun(Message_Encode, mixes[mix], 4, count / BENCH_RUNS, &checksum);
+            if (ns < best[1]) {
+                best[1] = ns;
+            }
+        }
+        printf("%-18s %9.1f ns %13.1f ns %7.2fx\n", mixNames[mix], best[0], best[1],
+                best[0] / best[1]);
+    }
+
+    printf("\n%-18s %12s %16s %8s\n", "traffic", "per byte", "per 4KB buffer", "speedup");
+    for (mix = 0; mix < 2; mix++) {
+        size_t length = BenchRecordTraffic(traffic, sizeof (traffic), mixes[mix], 4);
+        int passes = (megabytes << 20) / length / BENCH_RUNS + 1;
+        double best[2] = {1e9, 1e9};
+        for (run = 0; run < BENCH_RUNS; run++) {
+            double ns = BenchDecode(FALSE, traffic, length, passes, &checksum);
+            if (ns < best[0]) {
+                best[0] = ns;
+            }
+            ns = BenchDecode(TRUE, traffic, length, passes, &checksum);
+            if (ns < best[1]) {
+                best[1] = ns;
+            }
+        }
+        printf("%-18s %9.2f ns %13.2f ns %7.2fx\n", mixNames[mix], best[0], best[1],
+                best[0] / best[1]);
+    }
+    printf("(checksum %llu)\n", (unsigned long long) checksum);
+    return EXIT_SUCCESS;
+}
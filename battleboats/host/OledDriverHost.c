@@ -0,0 +1,52 @@
+/*
+ * File:   OledDriverHost.c
+ *
+ * Host replacement for OledDriver.c. Oled.c still draws into rgbOledBmp as usual. If the
+ * BB_HOST_OLED environment variable is set, every OledUpdate() prints the display to stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "OledDriver.h"
+
+uint8_t rgbOledBmp[OLED_DRIVER_BUFFER_SIZE];
+
+void OledHostInit(void)
+{
+}
+
+void OledDriverInitDisplay(void)
+{
+}
+
+void OledDriverDisableDisplay(void)
+{
+}
+
+void OledDriverUpdateDisplay(void)
+{
+    int row, col;
+    if (getenv("BB_HOST_OLED") == NULL) {
+        return;
+    }
+    // Each byte is a column of 8 pixels, with the least significant bit on top.
+    for (row = 0; row < OLED_DRIVER_PIXEL_ROWS; row++) {
+        char line[OLED_DRIVER_PIXEL_COLUMNS + 2];
+        for (col = 0; col < OLED_DRIVER_PIXEL_COLUMNS; col++) {
+            int index = (row / OLED_DRIVER_BUFFER_LINE_HEIGHT) * OLED_DRIVER_PIXEL_COLUMNS + col;
+            line[col] = (rgbOledBmp[index] >> (row % OLED_DRIVER_BUFFER_LINE_HEIGHT)) & 1 ? '#' : ' ';
+        }
+        line[OLED_DRIVER_PIXEL_COLUMNS] = '\n';
+        line[OLED_DRIVER_PIXEL_COLUMNS + 1] = '\0';
+        fputs(line, stderr);
+    }
+    fputs("\n", stderr);
+}
+
+void OledDriverSetDisplayInverted(void)
+{
+}
+
+void OledDriverSetDisplayNormal(void)
+{
+}
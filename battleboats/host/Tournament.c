@@ -0,0 +1,402 @@
+/*
+ * File:   Tournament.c
+ *
+ * Headless AI-vs-AI tournament. Plays complete games between two agent configurations through
+ * AgentContextRun(), with every message passed through Message_Encode() and
+ * Message_DecodeBufferWith() in memory just as it would cross the UART, and reports each side's
+ * win rate and shots-to-win with 95% confidence intervals, and the messages a game takes.
+ *
+ *     build/tournament [-n games] [-j threads] [-s seed] [-c] [player-a] [player-b]
+ *
+ * With -c both sides combine their turns, answering each SHO with a RAS (see
+ * AgentContextSetCombinedTurns()), as boards do once they have agreed to.
+ *
+ * Players are "density" (the built-in AI, the default for both), "scratch" (FieldAIDecideGuess()
+ * recomputed every shot; it should be indistinguishable from "density") and "random" (shoots a
+ * uniformly random unknown square; a baseline).
+ *
+ * Games are split into one contiguous range per worker thread. A worker takes small chunks from
+ * the front of its own range and, once that is empty, steals the back half of the largest range
+ * left, so threads stay busy to the end however long individual games run. Every game is seeded
+ * from the tournament seed and its index alone, so results do not depend on the thread count.
+ */
+
+#include <getopt.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "BOARD.h"
+#include "Agent.h"
+#include "Message.h"
+#include "Random.h"
+
+// Games a worker takes from its own range at a time.
+#define TOURNAMENT_CHUNK 16
+// A game still running after this many events is counted as unfinished.
+#define TOURNAMENT_MAX_EVENTS 1000
+// Events in flight in one game: a message's event for the receiver plus MESSAGE_SENT, twice over.
+#define TOURNAMENT_QUEUE 8
+
+typedef struct {
+    const char *name;
+    uint8_t (*place_boats)(Field *own_field, RandomState *rng);
+    GuessData (*decide_guess)(const Field *opp_field, RandomState *rng);
+} TournamentPlayer;
+
+typedef struct {
+    uint64_t games;
+    uint64_t unfinished;
+    uint64_t messages;
+    uint64_t wins[2];
+    uint64_t shots[2][FIELD_NUM_SQUARES + 1]; // Histogram of the winner's shots, by side.
+} TournamentStats;
+
+typedef struct {
+    pthread_mutex_t lock;
+    uint64_t next; // Games [next, end) are still to be played by this worker.
+    uint64_t end;
+    pthread_t thread;
+    TournamentStats stats;
+} TournamentWorker;
+
+typedef struct {
+    const TournamentPlayer *players[2];
+    uint32_t seed;
+    int threads;
+    uint8_t combined_turns;
+    TournamentWorker *workers;
+} Tournament;
+
+/**
+ * Shoots a uniformly random unknown square, or (0, 0) if none is left, as FieldAIPickDensest()
+ * does.
+ */
+static GuessData TournamentRandomGuess(const Field *opp_field, RandomState *rng)
+{
+    GuessData guess = {0, 0, RESULT_MISS};
+    FieldMask unknown = opp_field->unknown;
+    if (FieldMaskIsEmpty(&unknown)) {
+        return guess;
+    }
+    uint32_t pick = RandomBelow(rng, FieldMaskCount(&unknown));
+    uint16_t square = FieldMaskPopLowest(&unknown);
+    while (pick--) {
+        square = FieldMaskPopLowest(&unknown);
+    }
+    guess.row = square / FIELD_COLS;
+    guess.col = square % FIELD_COLS;
+    return guess;
+}
+
+static const TournamentPlayer tournamentPlayers[] = {
+    {"density", NULL, NULL},
+    {"scratch", NULL, FieldAIDecideGuessWith},
+    {"random", NULL, TournamentRandomGuess},
+};
+
+#define TOURNAMENT_NUM_PLAYERS (sizeof (tournamentPlayers) / sizeof (tournamentPlayers[0]))
+
+static const TournamentPlayer *TournamentFindPlayer(const char *name)
+{
+    unsigned int i;
+    for (i = 0; i < TOURNAMENT_NUM_PLAYERS; i++) {
+        if (strcmp(name, tournamentPlayers[i].name) == 0) {
+            return &tournamentPlayers[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Plays game number `game` to the end and records it in `stats`.
+ */
+static void TournamentPlayGame(const Tournament *t, uint64_t game, TournamentStats *stats)
+{
+    AgentContext agents[2];
+    MessageDecoder decoders[2];
+    struct {
+        uint8_t to;
+        BB_Event event;
+    } queue[TOURNAMENT_QUEUE];
+    int head = 0, tail = 0, events = 0, side, i;
+    uint8_t shots[2] = {0, 0};
+    char wire[MESSAGE_MAX_LEN + 1];
+    RandomState seeder;
+
+    RandomSeed(&seeder, t->seed);
+    RandomStir(&seeder, (uint32_t) game);
+    RandomStir(&seeder, (uint32_t) (game >> 32));
+    for (side = 0; side < 2; side++) {
+        AgentContextInit(&agents[side], FALSE, RandomNext(&seeder));
+        agents[side].place_boats = t->players[side]->place_boats;
+        agents[side].decide_guess = t->players[side]->decide_guess;
+        AgentContextSetCombinedTurns(&agents[side], t->combined_turns);
+        Message_DecoderInit(&decoders[side]);
+    }
+
+    // The sides take turns pressing the start button.
+    queue[tail].to = game & 1;
+    queue[tail].event.type = BB_EVENT_START_BUTTON;
+    tail = (tail + 1) % TOURNAMENT_QUEUE;
+    while (head != tail && events++ < TOURNAMENT_MAX_EVENTS) {
+        uint8_t from = queue[head].to;
+        Message reply = AgentContextRun(&agents[from], queue[head].event);
+        head = (head + 1) % TOURNAMENT_QUEUE;
+        if (reply.type == MESSAGE_NONE) {
+            continue;
+        }
+        if (reply.type == MESSAGE_SHO || reply.type == MESSAGE_RAS) {
+            shots[from]++;
+        }
+        stats->messages++;
+        // Send it over the wire.
+        BB_Event received[MESSAGE_MAX_LEN];
+        int length = Message_Encode(wire, reply);
+        int n = Message_DecodeBufferWith(&decoders[!from], (const uint8_t *) wire, length,
+                received, MESSAGE_MAX_LEN, NULL);
+        for (i = 0; i < n; i++) {
+            queue[tail].to = !from;
+            queue[tail].event = received[i];
+            tail = (tail + 1) % TOURNAMENT_QUEUE;
+        }
+        queue[tail].to = from;
+        queue[tail].event.type = BB_EVENT_MESSAGE_SENT;
+        tail = (tail + 1) % TOURNAMENT_QUEUE;
+    }
+
+    stats->games++;
+    for (side = 0; side < 2; side++) {
+        if (AgentContextGetState(&agents[side]) == AGENT_STATE_END_SCREEN &&
+                FieldGetBoatStates(&agents[side].opp_field) == 0 &&
+                FieldGetBoatStates(&agents[!side].own_field) == 0) {
+            // An AI that repeats squares could take more shots than there are squares.
+            int taken = shots[side] < FIELD_NUM_SQUARES ? shots[side] : FIELD_NUM_SQUARES;
+            stats->wins[side]++;
+            stats->shots[side][taken]++;
+            return;
+        }
+    }
+    stats->unfinished++;
+}
+
+/**
+ * Takes the next chunk of games from this worker's own range, or else steals half of the largest
+ * range left. Returns FALSE once every game has been handed out.
+ */
+static uint8_t TournamentTakeGames(Tournament *t, TournamentWorker *self, uint64_t *first,
+        uint64_t *last)
+{
+    int w;
+    for (;;) {
+        pthread_mutex_lock(&self->lock);
+        if (self->next < self->end) {
+            *first = self->next;
+            *last = self->end - self->next > TOURNAMENT_CHUNK ?
+                    self->next + TOURNAMENT_CHUNK : self->end;
+            self->next = *last;
+            pthread_mutex_unlock(&self->lock);
+            return TRUE;
+        }
+        pthread_mutex_unlock(&self->lock);
+
+        // Our own range is empty: look for the victim with the most games left. The sizes are
+        // read without locking, so a racing update can make one wrap; the steal below rechecks
+        // under the victim's lock.
+        TournamentWorker *victim = NULL;
+        uint64_t most = 0;
+        for (w = 0; w < t->threads; w++) {
+            TournamentWorker *other = &t->workers[w];
+            uint64_t left = __atomic_load_n(&other->end, __ATOMIC_RELAXED) -
+                    __atomic_load_n(&other->next, __ATOMIC_RELAXED);
+            if (other != self && left > most && left < UINT64_MAX / 2) {
+                most = left;
+                victim = other;
+            }
+        }
+        if (victim == NULL) {
+            return FALSE;
+        }
+        pthread_mutex_lock(&victim->lock);
+        uint64_t left = victim->end - victim->next;
+        if (left == 0) {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+        uint64_t middle = victim->next + left / 2;
+        uint64_t end = victim->end;
+        victim->end = middle;
+        pthread_mutex_unlock(&victim->lock);
+
+        pthread_mutex_lock(&self->lock);
+        self->next = middle;
+        self->end = end;
+        pthread_mutex_unlock(&self->lock);
+    }
+}
+
+static Tournament tournament;
+
+static void *TournamentWork(void *arg)
+{
+    TournamentWorker *self = arg;
+    uint64_t first, last;
+    while (TournamentTakeGames(&tournament, self, &first, &last)) {
+        for (; first < last; first++) {
+            TournamentPlayGame(&tournament, first, &self->stats);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Returns the smallest number of shots that at least `fraction` of the wins took.
+ */
+static int TournamentPercentile(const uint64_t histogram[FIELD_NUM_SQUARES + 1], uint64_t wins,
+        double fraction)
+{
+    uint64_t seen = 0;
+    int shots;
+    for (shots = 0; shots < FIELD_NUM_SQUARES; shots++) {
+        seen += histogram[shots];
+        if (seen >= fraction * wins) {
+            break;
+        }
+    }
+    return shots;
+}
+
+static void TournamentReport(const TournamentStats *stats, int side)
+{
+    const uint64_t *histogram = stats->shots[side];
+    uint64_t wins = stats->wins[side];
+    uint64_t decided = stats->wins[0] + stats->wins[1];
+    double sum = 0.0, squares = 0.0;
+    int shots;
+
+    // Wilson score interval for the win rate.
+    double z = 1.96;
+    double p = decided ? (double) wins / decided : 0.0;
+    double n = decided ? decided : 1;
+    double centre = (p + z * z / (2 * n)) / (1 + z * z / n);
+    double spread = z * sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+    printf("%-8s wins %7.3f%%  [%.3f%%, %.3f%%]\n", tournament.players[side]->name,
+            100 * p, 100 * (centre - spread), 100 * (centre + spread));
+    if (wins == 0) {
+        return;
+    }
+
+    for (shots = 0; shots <= FIELD_NUM_SQUARES; shots++) {
+        sum += (double) shots * histogram[shots];
+        squares += (double) shots * shots * histogram[shots];
+    }
+    double mean = sum / wins;
+    double variance = wins > 1 ? (squares - sum * mean) / (wins - 1) : 0.0;
+    printf("         shots to win: mean %.3f +/- %.3f, p50 %d, p90 %d, p99 %d\n",
+            mean, z * sqrt(variance / wins),
+            TournamentPercentile(histogram, wins, 0.50),
+            TournamentPercentile(histogram, wins, 0.90),
+            TournamentPercentile(histogram, wins, 0.99));
+}
+
+static void TournamentUsage(const char *program)
+{
+    unsigned int i;
+    fprintf(stderr, "usage: %s [-n games] [-j threads] [-s seed] [-c] [player-a] [player-b]\n"
+            "players:", program);
+    for (i = 0; i < TOURNAMENT_NUM_PLAYERS; i++) {
+        fprintf(stderr, " %s", tournamentPlayers[i].name);
+    }
+    fprintf(stderr, "\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t games = 100000;
+    struct timespec start, stop;
+    TournamentStats total;
+    int opt, w, side, i;
+
+    tournament.seed = 1;
+    tournament.threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    while ((opt = getopt(argc, argv, "n:j:s:c")) != -1) {
+        switch (opt) {
+            case 'n':
+                games = strtoull(optarg, NULL, 0);
+                break;
+            case 'j':
+                tournament.threads = atoi(optarg);
+                break;
+            case 's':
+                tournament.seed = strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                tournament.combined_turns = TRUE;
+                break;
+            default:
+                TournamentUsage(argv[0]);
+        }
+    }
+    for (side = 0; side < 2; side++) {
+        const char *name = optind < argc ? argv[optind++] : "density";
+        tournament.players[side] = TournamentFindPlayer(name);
+        if (tournament.players[side] == NULL) {
+            TournamentUsage(argv[0]);
+        }
+    }
+    if (tournament.threads < 1) {
+        tournament.threads = 1;
+    }
+    tournament.workers = calloc(tournament.threads, sizeof (TournamentWorker));
+    if (tournament.workers == NULL) {
+        FATAL_ERROR();
+    }
+    for (w = 0; w < tournament.threads; w++) {
+        TournamentWorker *worker = &tournament.workers[w];
+        pthread_mutex_init(&worker->lock, NULL);
+        worker->next = games * w / tournament.threads;
+        worker->end = games * (w + 1) / tournament.threads;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (w = 1; w < tournament.threads; w++) {
+        if (pthread_create(&tournament.workers[w].thread, NULL, TournamentWork,
+                &tournament.workers[w]) != 0) {
+            FATAL_ERROR();
+        }
+    }
+    TournamentWork(&tournament.workers[0]);
+    for (w = 1; w < tournament.threads; w++) {
+        pthread_join(tournament.workers[w].thread, NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    memset(&total, 0, sizeof (total));
+    for (w = 0; w < tournament.threads; w++) {
+        const TournamentStats *stats = &tournament.workers[w].stats;
+        total.games += stats->games;
+        total.unfinished += stats->unfinished;
+        total.messages += stats->messages;
+        for (side = 0; side < 2; side++) {
+            total.wins[side] += stats->wins[side];
+            for (i = 0; i <= FIELD_NUM_SQUARES; i++) {
+                total.shots[side][i] += stats->shots[side][i];
+            }
+        }
+    }
+    double seconds = (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+    printf("%llu games (%llu unfinished) in %.2fs on %d threads, %.0f games/s, seed %lu\n",
+            (unsigned long long) total.games, (unsigned long long) total.unfinished, seconds,
+            tournament.threads, total.games / seconds, (unsigned long) tournament.seed);
+    printf("%.3f messages per game%s\n", total.games ? (double) total.messages / total.games : 0.0,
+            tournament.combined_turns ? ", turns combined" : "");
+    for (side = 0; side < 2; side++) {
+        TournamentReport(&total, side);
+    }
+    free(tournament.workers);
+    return total.unfinished == 0 ? 0 : 1;
+}
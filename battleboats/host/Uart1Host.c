@@ -0,0 +1,114 @@
+/*
+ * File:   Uart1Host.c
+ *
+ * Host replacement for Uart1.c, with stdin and stdout as the serial line. Writes go straight to
+ * stdout. Uart1HostInterrupt(), which BoardHost.c calls from its 100Hz tick, stands in for the
+ * UART interrupt: it reads any bytes waiting on a non-blocking stdin into the same kind of
+ * receive queue that Uart1.c uses, and reports finished writes to the TX done callback.
+ *
+ * Two host agents can play each other by cross-connecting them, e.g. with socat:
+ *   socat EXEC:./build/battleboats EXEC:./build/battleboats
+ */
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include "BOARD.h"
+#include "ByteQueue.h"
+#include "Uart1.h"
+
+static ByteQueue uart1RxQueue;
+static uint8_t u1RxBuf[1024];
+static uint8_t u1TxSpan[256]; // There is no transmit buffer; spans are written out on commit.
+static void (*uart1TxDoneCallback)(void);
+static volatile sig_atomic_t uart1TxPending;
+
+/**
+ * Moves any bytes waiting on stdin into the receive queue and reports finished writes.  It runs
+ * in the SIGALRM handler, so like the UART interrupt it is the queue's only producer.
+ */
+void Uart1HostInterrupt(void)
+{
+    uint8_t bytes[64];
+    ssize_t n;
+    if (uart1TxPending) {
+        uart1TxPending = FALSE;
+        if (uart1TxDoneCallback) {
+            uart1TxDoneCallback();
+        }
+    }
+    if (uart1RxQueue.data == NULL) {
+        return; // Uart1Init() has not been called yet.
+    }
+    while ((n = read(STDIN_FILENO, bytes, sizeof (bytes))) > 0) {
+        ByteQueue_Write(&uart1RxQueue, bytes, n);
+    }
+}
+
+void Uart1Init(uint32_t baudRate)
+{
+    (void) baudRate;
+    ByteQueue_Init(&uart1RxQueue, u1RxBuf, sizeof (u1RxBuf));
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+}
+
+void Uart1ChangeBaudRate(uint16_t brgRegister)
+{
+    (void) brgRegister;
+}
+
+uint8_t Uart1HasData(void)
+{
+    return (ByteQueue_Count(&uart1RxQueue) > 0);
+}
+
+int Uart1ReadByte(uint8_t *datum)
+{
+    return ByteQueue_ReadByte(&uart1RxQueue, datum);
+}
+
+void Uart1WriteByte(uint8_t datum)
+{
+    Uart1WriteData(&datum, 1);
+}
+
+int Uart1WriteData(const void *data, size_t length)
+{
+    const uint8_t *bytes = data;
+    while (length > 0) {
+        ssize_t n = write(STDOUT_FILENO, bytes, length);
+        if (n <= 0) {
+            return STANDARD_ERROR;
+        }
+        bytes += n;
+        length -= n;
+    }
+    uart1TxPending = TRUE;
+    return SUCCESS;
+}
+
+const uint8_t *Uart1GetReadSpan(uint16_t *size)
+{
+    return ByteQueue_GetReadSpan(&uart1RxQueue, size);
+}
+
+void Uart1CommitRead(uint16_t size)
+{
+    ByteQueue_CommitRead(&uart1RxQueue, size);
+}
+
+uint8_t *Uart1GetWriteSpan(uint16_t *size)
+{
+    *size = sizeof (u1TxSpan);
+    return u1TxSpan;
+}
+
+int Uart1CommitWrite(uint16_t size)
+{
+    return Uart1WriteData(u1TxSpan, size);
+}
+
+void Uart1SetTxDoneCallback(void (*callback)(void))
+{
+    uart1TxDoneCallback = callback;
+}
@@ -0,0 +1,12 @@
+/*
+ * File:   attribs.h
+ *
+ * Host stand-in for the XC32 attribute macros. An __ISR function becomes an ordinary function,
+ * which BoardHost.c calls from its timer signal handler.
+ */
+#ifndef HOST_SYS_ATTRIBS_H
+#define HOST_SYS_ATTRIBS_H
+
+#define __ISR(vector, ...)
+
+#endif // HOST_SYS_ATTRIBS_H
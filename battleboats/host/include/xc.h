@@ -0,0 +1,30 @@
+/*
+ * File:   xc.h
+ *
+ * Host stand-in for the XC32 device header. The special function registers that the game code
+ * touches are plain variables here, defined in BoardHost.c, so configuring a peripheral is a
+ * harmless write. The behavior of those peripherals is provided by the other *Host.c shims.
+ */
+#ifndef HOST_XC_H
+#define HOST_XC_H
+
+#include <stdint.h>
+
+/**
+ * One type for every bitfield SFR used by the game code, with the union of the fields it needs.
+ */
+typedef struct {
+    uint32_t ON : 1;
+    uint32_t TCKPS : 3;
+    uint32_t T2IF : 1;
+    uint32_t T2IE : 1;
+    uint32_t T2IP : 3;
+    uint32_t T2IS : 2;
+} HostSfrBits;
+
+extern volatile uint32_t T2CON, PR2, IFS0CLR;
+extern volatile uint32_t TRISE, LATE;
+extern volatile uint32_t PORTD, PORTF;
+extern volatile HostSfrBits T2CONbits, IFS0bits, IEC0bits, IPC2bits;
+
+#endif // HOST_XC_H